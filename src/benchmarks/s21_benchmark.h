@@ -0,0 +1,55 @@
+#ifndef S21_CONTAINERS_BENCHMARKS_S21_BENCHMARK_H
+#define S21_CONTAINERS_BENCHMARKS_S21_BENCHMARK_H
+
+#include <malloc.h>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+ * @file s21_benchmark.h
+ * @brief Minimal timing helpers shared by the benchmark programs
+ * @details Every benchmark is a standalone program built with -O2 by
+ * `make benchmark`. Results are printed as one line per measurement so two
+ * implementations can be compared side by side.
+ */
+
+namespace s21_bench {
+
+// Runs body once and returns the elapsed wall time in milliseconds
+template <typename Body>
+double Measure(Body body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+inline void Report(const char *name, const char *container, std::size_t ops,
+                   double ms) {
+  std::printf("%-28s %-16s %10zu ops %10.2f ms %8.2f Mops/s\n", name,
+              container, ops, ms, ms > 0 ? ops / ms / 1000.0 : 0.0);
+}
+
+inline std::vector<int> RandomKeys(std::size_t count, unsigned seed = 42) {
+  std::vector<int> keys(count);
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist;
+  for (auto &key : keys) key = dist(gen);
+  return keys;
+}
+
+// Heap bytes in use, to compare the footprint of containers
+inline std::size_t HeapInUse() { return mallinfo2().uordblks; }
+
+// Keeps the optimizer from discarding a computed value
+template <typename T>
+inline void DoNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace s21_bench
+
+#endif  // S21_CONTAINERS_BENCHMARKS_S21_BENCHMARK_H
@@ -0,0 +1,57 @@
+// 1) Related header
+#include "components/s21_btree_map.h"
+// 2) C system headers
+// 3) C++ standard library headers
+#include <map>
+#include <vector>
+// 4) other libraries' headers
+// 5) project's headers.
+#include "benchmarks/s21_benchmark.h"
+#include "components/s21_map.h"
+
+namespace {
+
+constexpr int kLookups = 2000000;
+
+// Fills a map with count random keys, then reports its heap bytes per
+// entry and the latency of random lookups, half of them misses
+template <typename Map>
+void Lookups(const char *container, std::size_t count) {
+  std::vector<int> keys = s21_bench::RandomKeys(count, 7);
+  std::vector<int> probes = s21_bench::RandomKeys(kLookups, 11);
+  for (int i = 0; i < kLookups; i += 2) probes[i] = keys[probes[i] % count];
+
+  std::size_t before = s21_bench::HeapInUse();
+  Map map;
+  double insert_ms = s21_bench::Measure([&map, &keys] {
+    for (int key : keys) map[key] = key;
+  });
+  double bytes =
+      static_cast<double>(s21_bench::HeapInUse() - before) / map.size();
+
+  std::size_t hits = 0;
+  double find_ms = s21_bench::Measure([&map, &probes, &hits] {
+    for (int key : probes) hits += map.find(key) != map.end();
+  });
+  s21_bench::DoNotOptimize(hits);
+
+  s21_bench::Report("insert random", container, count, insert_ms);
+  s21_bench::Report("find random", container, kLookups, find_ms);
+  std::printf("%-28s %-16s %10.1f bytes/entry %6.1f ns/find\n",
+              "footprint and latency", container, bytes,
+              find_ms * 1e6 / kLookups);
+}
+
+}  // namespace
+
+int main() {
+  for (std::size_t count : {std::size_t{10000}, std::size_t{1000000}}) {
+    std::printf("%zu entries\n", count);
+    Lookups<s21::btree_map<int, int>>("s21::btree_map", count);
+    Lookups<s21::btree_map<int, int, std::less<int>, 4096>>(
+        "btree_map<4096>", count);
+    Lookups<s21::map<int, int>>("s21::map", count);
+    Lookups<std::map<int, int>>("std::map", count);
+  }
+  return 0;
+}
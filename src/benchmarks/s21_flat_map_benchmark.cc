@@ -0,0 +1,85 @@
+// 1) Related header
+#include "components/s21_flat_map.h"
+// 2) C system headers
+// 3) C++ standard library headers
+#include <map>
+#include <utility>
+#include <vector>
+// 4) other libraries' headers
+// 5) project's headers.
+#include "benchmarks/s21_benchmark.h"
+#include "components/s21_btree_map.h"
+#include "components/s21_map.h"
+
+namespace {
+
+constexpr std::size_t kCount = 1000000;
+constexpr int kLookups = 2000000;
+constexpr int kScans = 20;
+
+using Pairs = std::vector<std::pair<int, int>>;
+
+// Filling, the container's way: one bulk merge for the flat map, one
+// insert per entry for the trees
+void Fill(s21::flat_map<int, int> &map, const Pairs &pairs) {
+  map.insert(pairs.begin(), pairs.end());
+}
+template <typename Map>
+void Fill(Map &map, const Pairs &pairs) {
+  for (const auto &[key, value] : pairs) map[key] = value;
+}
+
+template <typename Iterator>
+int ValueOf(const Iterator &it) {
+  return it->value_;
+}
+int ValueOf(std::map<int, int>::const_iterator it) { return it->second; }
+
+// A read-mostly table: built once, then probed and exported in full
+template <typename Map>
+void Table(const char *container, const Pairs &pairs,
+           const std::vector<int> &probes) {
+  std::size_t before = s21_bench::HeapInUse();
+  Map map;
+  double fill_ms = s21_bench::Measure([&map, &pairs] { Fill(map, pairs); });
+  double bytes =
+      static_cast<double>(s21_bench::HeapInUse() - before) / map.size();
+
+  std::size_t hits = 0;
+  double find_ms = s21_bench::Measure([&map, &probes, &hits] {
+    for (int key : probes) hits += map.find(key) != map.end();
+  });
+  long long sum = 0;
+  double scan_ms = s21_bench::Measure([&map, &sum] {
+    const Map &table = map;
+    for (int round = 0; round < kScans; ++round) {
+      for (auto it = table.begin(); it != table.end(); ++it) {
+        sum += ValueOf(it);
+      }
+    }
+  });
+  s21_bench::DoNotOptimize(hits);
+  s21_bench::DoNotOptimize(sum);
+
+  s21_bench::Report("fill", container, pairs.size(), fill_ms);
+  s21_bench::Report("find random", container, probes.size(), find_ms);
+  s21_bench::Report("full scan", container, kScans * map.size(), scan_ms);
+  std::printf("%-28s %-16s %10.1f bytes/entry\n", "footprint", container,
+              bytes);
+}
+
+}  // namespace
+
+int main() {
+  std::vector<int> keys = s21_bench::RandomKeys(kCount, 3);
+  Pairs pairs;
+  for (int key : keys) pairs.emplace_back(key, key / 2);
+  std::vector<int> probes = s21_bench::RandomKeys(kLookups, 5);
+  for (int i = 0; i < kLookups; i += 2) probes[i] = keys[probes[i] % kCount];
+
+  Table<s21::flat_map<int, int>>("s21::flat_map", pairs, probes);
+  Table<s21::btree_map<int, int>>("s21::btree_map", pairs, probes);
+  Table<s21::map<int, int>>("s21::map", pairs, probes);
+  Table<std::map<int, int>>("std::map", pairs, probes);
+  return 0;
+}
@@ -0,0 +1,89 @@
+// 1) Related header
+#include "components/s21_set.h"
+// 2) C system headers
+// 3) C++ standard library headers
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+// 4) other libraries' headers
+// 5) project's headers.
+#include "benchmarks/s21_benchmark.h"
+
+namespace {
+
+constexpr int kProbes = 2000000;
+
+// Every second probe hits: keys are the even numbers below 2 * size
+std::vector<int> Probes(int size) {
+  std::vector<int> probes = s21_bench::RandomKeys(kProbes, 7);
+  for (auto &probe : probes) probe %= 2 * size;
+  return probes;
+}
+
+// Membership tests against a set far larger than the cache, one descent
+// after the other versus interleaved by contains_many
+void Lookup(int size, const char *label) {
+  std::vector<int> keys(size);
+  for (int i = 0; i < size; ++i) keys[i] = 2 * i;
+  s21::set<int> set(keys.begin(), keys.end());
+  // Random insertion order scatters the nodes like a long-lived set would
+  std::vector<int> shuffled = s21_bench::RandomKeys(size, 3);
+  s21::set<int> scattered;
+  for (int key : shuffled) scattered.insert((key % (2 * size)) & ~1);
+  std::vector<int> probes = Probes(size);
+
+  for (auto *target : {&set, &scattered}) {
+    const char *layout = target == &set ? "sorted" : "scattered";
+    std::size_t hits = 0;
+    double ms = s21_bench::Measure([target, &probes, &hits] {
+      for (int probe : probes) hits += target->contains(probe);
+    });
+    s21_bench::DoNotOptimize(hits);
+    char name[48];
+    std::snprintf(name, sizeof(name), "contains %s %s", label, layout);
+    s21_bench::Report(name, "s21::set", kProbes, ms);
+
+    std::vector<bool> found;
+    ms = s21_bench::Measure([target, &probes, &found] {
+      found = target->contains_many(probes.begin(), probes.end());
+    });
+    s21_bench::DoNotOptimize(std::count(found.begin(), found.end(), true));
+    std::snprintf(name, sizeof(name), "contains_many %s %s", label, layout);
+    s21_bench::Report(name, "s21::set", kProbes, ms);
+  }
+}
+
+// Sorted probes, as in a merge join: every lookup lands just after the
+// previous one, which a finger exploits and a root descent does not
+void SortedProbes(int size, const char *label) {
+  std::vector<int> keys(size);
+  for (int i = 0; i < size; ++i) keys[i] = 2 * i;
+  s21::set<int> set(keys.begin(), keys.end());
+  std::vector<int> probes = Probes(size);
+  std::sort(probes.begin(), probes.end());
+
+  std::size_t hits = 0;
+  double ms = s21_bench::Measure([&set, &probes, &hits] {
+    for (int probe : probes) hits += set.contains(probe);
+  });
+  char name[48];
+  std::snprintf(name, sizeof(name), "sorted contains %s", label);
+  s21_bench::Report(name, "s21::set", kProbes, ms);
+
+  ms = s21_bench::Measure([&set, &probes, &hits] {
+    set.merge_join(probes.begin(), probes.end(),
+                   [&hits](int, auto) { ++hits; });
+  });
+  s21_bench::DoNotOptimize(hits);
+  std::snprintf(name, sizeof(name), "sorted merge_join %s", label);
+  s21_bench::Report(name, "s21::set", kProbes, ms);
+}
+
+}  // namespace
+
+int main() {
+  Lookup(1000000, "1e6");
+  Lookup(10000000, "1e7");
+  SortedProbes(1000000, "1e6");
+  return 0;
+}
@@ -0,0 +1,122 @@
+// 1) Related header
+#include "components/s21_map.h"
+// 2) C system headers
+// 3) C++ standard library headers
+#include <map>
+#include <string>
+// 4) other libraries' headers
+// 5) project's headers.
+#include "benchmarks/s21_benchmark.h"
+
+namespace {
+
+constexpr int kKeys = 1000000;
+
+template <typename Map>
+void SortedInsert(const char *container) {
+  Map map;
+  double ms = s21_bench::Measure([&map] {
+    for (int i = 0; i < kKeys; ++i) map.insert({i, i});
+  });
+  s21_bench::Report("sorted insert", container, kKeys, ms);
+}
+
+// Appends sorted keys with end() as the hint, which is always right
+template <typename Map>
+void HintedInsert(const char *container) {
+  Map map;
+  double ms = s21_bench::Measure([&map] {
+    for (int i = 0; i < kKeys; ++i) map.emplace_hint(map.end(), i, i);
+  });
+  s21_bench::Report("hinted sorted insert", container, kKeys, ms);
+}
+
+// Counter updates: every key is looked up, created on first sight and
+// incremented, all through operator[]
+template <typename Map>
+void Upsert(const char *container) {
+  Map map;
+  std::vector<int> keys = s21_bench::RandomKeys(kKeys);
+  for (auto &key : keys) key %= kKeys / 10;
+  double ms = s21_bench::Measure([&map, &keys] {
+    for (int key : keys) ++map[key];
+  });
+  s21_bench::DoNotOptimize(map.size());
+  s21_bench::Report("upsert via operator[]", container, kKeys, ms);
+}
+
+template <typename Map>
+void RandomLookup(const char *container) {
+  Map map;
+  for (int i = 0; i < kKeys; ++i) map.insert({i, i});
+  std::vector<int> probes = s21_bench::RandomKeys(kKeys);
+  for (auto &probe : probes) probe %= kKeys;
+
+  std::size_t found = 0;
+  double ms = s21_bench::Measure([&map, &probes, &found] {
+    for (int probe : probes) found += map.find(probe) != map.end();
+  });
+  s21_bench::DoNotOptimize(found);
+  s21_bench::Report("random lookup", container, kKeys, ms);
+}
+
+// Keeps the map at a fixed size while inserting and erasing at equal rates;
+// the cost per operation should only grow with log(size)
+template <typename Map>
+void Churn(const char *container, int size) {
+  Map map;
+  for (int i = 0; i < size; ++i) map.insert({i, i});
+  constexpr int kOps = 1000000;
+  double ms = s21_bench::Measure([&map, size] {
+    for (int i = size; i < size + kOps; ++i) {
+      map.insert({i, i});
+      map.erase(map.find(i - size));
+    }
+  });
+  char name[32];
+  std::snprintf(name, sizeof(name), "churn at size %d", size);
+  s21_bench::Report(name, container, kOps, ms);
+}
+
+// TTL sweep over a map built in random key order: drops the 30% of entries
+// whose deadline has passed, one erase(pos) at a time versus one erase_if
+void Sweep(bool bulk) {
+  std::vector<int> deadlines = s21_bench::RandomKeys(kKeys);
+  std::vector<int> keys = s21_bench::RandomKeys(kKeys, 3);
+  s21::map<int, int> map;
+  for (int i = 0; i < kKeys; ++i) map.insert({keys[i], deadlines[i] % 100});
+
+  std::size_t size = map.size();
+  double ms = s21_bench::Measure([&map, bulk] {
+    if (bulk) {
+      s21::erase_if(map, [](const auto &entry) { return entry.value_ < 30; });
+      return;
+    }
+    for (auto it = map.begin(); it != map.end();) {
+      it = it->value_ < 30 ? map.erase(it) : std::next(it);
+    }
+  });
+  s21_bench::DoNotOptimize(map.size());
+  s21_bench::Report(bulk ? "sweep 30% erase_if" : "sweep 30% erase(pos)",
+                    "s21::map", size, ms);
+}
+
+}  // namespace
+
+int main() {
+  SortedInsert<s21::map<int, int>>("s21::map");
+  SortedInsert<std::map<int, int>>("std::map");
+  HintedInsert<s21::map<int, int>>("s21::map");
+  HintedInsert<std::map<int, int>>("std::map");
+  Upsert<s21::map<int, int>>("s21::map");
+  Upsert<std::map<int, int>>("std::map");
+  RandomLookup<s21::map<int, int>>("s21::map");
+  RandomLookup<std::map<int, int>>("std::map");
+  for (int size : {1000, 100000, 1000000}) {
+    Churn<s21::map<int, int>>("s21::map", size);
+    Churn<std::map<int, int>>("std::map", size);
+  }
+  Sweep(false);
+  Sweep(true);
+  return 0;
+}
@@ -0,0 +1,51 @@
+// 1) Related header
+#include "components/s21_parallel.h"
+// 2) C system headers
+// 3) C++ standard library headers
+#include <cstdio>
+#include <thread>
+#include <vector>
+// 4) other libraries' headers
+// 5) project's headers.
+#include "benchmarks/s21_benchmark.h"
+#include "components/s21_map.h"
+
+namespace {
+
+constexpr int kKeys = 10000000;
+
+// Sum of the mapped values over a large map with a scattered node layout,
+// serial iteration versus parallel_reduce on more and more threads
+void Aggregate() {
+  std::vector<int> keys = s21_bench::RandomKeys(kKeys, 9);
+  s21::map<int, int> map;
+  for (int key : keys) map.insert({key, key & 0xff});
+
+  long long sum = 0;
+  double ms = s21_bench::Measure([&map, &sum] {
+    for (auto it = map.begin(); it != map.end(); ++it) sum += it->value_;
+  });
+  s21_bench::DoNotOptimize(sum);
+  s21_bench::Report("serial iteration", "s21::map", map.size(), ms);
+
+  unsigned cores = std::max(1U, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= 2 * cores; threads *= 2) {
+    ms = s21_bench::Measure([&map, &sum, threads] {
+      sum = s21::parallel_reduce(
+          map, 0LL, [](const auto &entry) { return entry.value_; },
+          [](long long left, long long right) { return left + right; },
+          threads);
+    });
+    s21_bench::DoNotOptimize(sum);
+    char name[48];
+    std::snprintf(name, sizeof(name), "parallel_reduce %u threads", threads);
+    s21_bench::Report(name, "s21::map", map.size(), ms);
+  }
+}
+
+}  // namespace
+
+int main() {
+  Aggregate();
+  return 0;
+}
@@ -0,0 +1,73 @@
+// 1) Related header
+#include "components/s21_persistent_map.h"
+// 2) C system headers
+// 3) C++ standard library headers
+#include <vector>
+// 4) other libraries' headers
+// 5) project's headers.
+#include "benchmarks/s21_benchmark.h"
+#include "components/s21_map.h"
+
+namespace {
+
+constexpr int kKeys = 1000000;
+constexpr int kSnapshots = 10;
+
+// What a reader pays for a private, stable view of the table: a full copy
+// of an s21::map versus a persistent_map snapshot
+void Snapshots(const std::vector<int> &keys) {
+  s21::map<int, int> map;
+  s21::persistent_map<int, int> persistent;
+  for (int key : keys) {
+    map.insert({key, key});
+    persistent.insert({key, key});
+  }
+
+  std::size_t total = 0;
+  double ms = s21_bench::Measure([&map, &total] {
+    for (int i = 0; i < kSnapshots; ++i) {
+      s21::map<int, int> copy(map);
+      total += copy.size();
+    }
+  });
+  s21_bench::Report("snapshot (full copy)", "s21::map", kSnapshots, ms);
+
+  ms = s21_bench::Measure([&persistent, &total] {
+    for (int i = 0; i < kSnapshots; ++i) {
+      total += persistent.snapshot().size();
+    }
+  });
+  s21_bench::DoNotOptimize(total);
+  s21_bench::Report("snapshot", "persistent_map", kSnapshots, ms);
+}
+
+// The price of path copying on the writer side
+void Updates(const std::vector<int> &keys) {
+  s21::map<int, int> map;
+  double ms = s21_bench::Measure([&map, &keys] {
+    for (int key : keys) map.insert_or_assign(key, key);
+  });
+  s21_bench::Report("insert_or_assign", "s21::map", keys.size(), ms);
+
+  s21::persistent_map<int, int> persistent;
+  ms = s21_bench::Measure([&persistent, &keys] {
+    for (int key : keys) persistent.insert_or_assign(key, key);
+  });
+  s21_bench::Report("insert_or_assign", "persistent_map", keys.size(), ms);
+
+  std::size_t found = 0;
+  ms = s21_bench::Measure([&persistent, &keys, &found] {
+    for (int key : keys) found += persistent.contains(key);
+  });
+  s21_bench::DoNotOptimize(found);
+  s21_bench::Report("contains", "persistent_map", keys.size(), ms);
+}
+
+}  // namespace
+
+int main() {
+  std::vector<int> keys = s21_bench::RandomKeys(kKeys);
+  Snapshots(keys);
+  Updates(keys);
+  return 0;
+}
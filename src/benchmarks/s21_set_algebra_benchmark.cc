@@ -0,0 +1,60 @@
+// 1) Related header
+#include "components/s21_set_algebra.h"
+// 2) C system headers
+// 3) C++ standard library headers
+#include <vector>
+// 4) other libraries' headers
+// 5) project's headers.
+#include "benchmarks/s21_benchmark.h"
+
+namespace {
+
+constexpr int kKeys = 1000000;
+
+s21::set<int> RandomSet(int count, unsigned seed) {
+  std::vector<int> keys = s21_bench::RandomKeys(count, seed);
+  for (auto &key : keys) key %= 4 * kKeys;
+  return s21::set<int>(keys.begin(), keys.end());
+}
+
+// Segment intersection: the contains() loop it replaces, the merge-walk
+// with a bulk build, the parallel walk, and the in-place variant
+void Intersection(int right_count, const char *label) {
+  s21::set<int> left = RandomSet(kKeys, 1);
+  s21::set<int> right = RandomSet(right_count, 2);
+
+  std::size_t size = 0;
+  double ms = s21_bench::Measure([&left, &right, &size] {
+    s21::set<int> result;
+    for (auto it = left.begin(); it != left.end(); ++it) {
+      if (right.contains(*it)) result.insert(*it);
+    }
+    size = result.size();
+  });
+  s21_bench::Report("contains loop", label, left.size(), ms);
+
+  ms = s21_bench::Measure([&left, &right, &size] {
+    size = s21::set_intersection(left, right).size();
+  });
+  s21_bench::Report("set_intersection", label, left.size(), ms);
+
+  ms = s21_bench::Measure([&left, &right, &size] {
+    size = s21::parallel_set_intersection(left, right).size();
+  });
+  s21_bench::Report("parallel intersection", label, left.size(), ms);
+
+  ms = s21_bench::Measure([&left, &right, &size] {
+    left.intersect(right);
+    size = left.size();
+  });
+  s21_bench::DoNotOptimize(size);
+  s21_bench::Report("intersect in place", label, kKeys, ms);
+}
+
+}  // namespace
+
+int main() {
+  Intersection(kKeys, "set 1e6 x 1e6");
+  Intersection(kKeys / 100, "set 1e6 x 1e4");
+  return 0;
+}
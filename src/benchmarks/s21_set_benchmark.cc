@@ -0,0 +1,84 @@
+// 1) Related header
+#include "components/s21_set.h"
+// 2) C system headers
+// 3) C++ standard library headers
+#include <algorithm>
+#include <numeric>
+#include <set>
+// 4) other libraries' headers
+// 5) project's headers.
+#include "benchmarks/s21_benchmark.h"
+
+namespace {
+
+constexpr int kKeys = 1000000;
+
+template <typename Set>
+void RangeBuild(const char *name, const char *container,
+                const std::vector<int> &keys) {
+  std::size_t size = 0;
+  double ms = s21_bench::Measure([&keys, &size] {
+    Set set(keys.begin(), keys.end());
+    size = set.size();
+  });
+  s21_bench::DoNotOptimize(size);
+  s21_bench::Report(name, container, keys.size(), ms);
+}
+
+template <typename Set>
+void InsertOneByOne(const char *name, const char *container,
+                    const std::vector<int> &keys) {
+  std::size_t size = 0;
+  double ms = s21_bench::Measure([&keys, &size] {
+    Set set;
+    for (int key : keys) set.insert(key);
+    size = set.size();
+  });
+  s21_bench::DoNotOptimize(size);
+  s21_bench::Report(name, container, keys.size(), ms);
+}
+
+template <typename Set>
+void Storage(const char *container, const std::vector<int> &keys) {
+  std::size_t before = s21_bench::HeapInUse();
+  Set set;
+  double insert_ms = s21_bench::Measure([&set, &keys] {
+    for (int key : keys) set.insert(key);
+  });
+  std::size_t bytes = s21_bench::HeapInUse() - before;
+
+  long long sum = 0;
+  double iterate_ms = s21_bench::Measure([&set, &sum] {
+    for (auto it = set.begin(); it != set.end(); ++it) sum += *it;
+  });
+  s21_bench::DoNotOptimize(sum);
+  std::size_t size = set.size();
+  double clear_ms = s21_bench::Measure([&set] { set.clear(); });
+
+  s21_bench::Report("random insert", container, keys.size(), insert_ms);
+  s21_bench::Report("in-order iteration", container, size, iterate_ms);
+  s21_bench::Report("clear", container, size, clear_ms);
+  std::printf("%-28s %-16s %10.1f bytes/element\n", "memory", container,
+              static_cast<double>(bytes) / size);
+}
+
+}  // namespace
+
+int main() {
+  std::vector<int> sorted(kKeys);
+  std::iota(sorted.begin(), sorted.end(), 0);
+  std::vector<int> shuffled = s21_bench::RandomKeys(kKeys);
+
+  RangeBuild<s21::set<int>>("build sorted range", "s21::set", sorted);
+  RangeBuild<std::set<int>>("build sorted range", "std::set", sorted);
+  InsertOneByOne<s21::set<int>>("insert sorted 1 by 1", "s21::set", sorted);
+  RangeBuild<s21::set<int>>("build unsorted range", "s21::set", shuffled);
+  RangeBuild<std::set<int>>("build unsorted range", "std::set", shuffled);
+  InsertOneByOne<s21::set<int>>("insert unsorted 1 by 1", "s21::set",
+                                shuffled);
+  Storage<s21::set<int>>("s21::set heap", shuffled);
+  Storage<s21::set<int, std::less<int>, s21::PoolStorage>>("s21::set pool",
+                                                           shuffled);
+  Storage<std::set<int>>("std::set", shuffled);
+  return 0;
+}
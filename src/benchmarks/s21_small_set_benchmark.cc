@@ -0,0 +1,60 @@
+// 1) Related header
+#include "components/s21_small_set.h"
+// 2) C system headers
+// 3) C++ standard library headers
+#include <set>
+#include <vector>
+// 4) other libraries' headers
+// 5) project's headers.
+#include "benchmarks/s21_benchmark.h"
+
+namespace {
+
+constexpr int kSets = 1000000;
+constexpr int kKeysPerSet = 5;
+
+// Per-entity state: a million sets of a handful of keys each, filled,
+// probed and destroyed
+template <typename Set>
+void TinySets(const char *container, const std::vector<int> &keys) {
+  std::vector<Set> sets(kSets);
+  // Allocations made by the sets themselves, not the vector holding them
+  std::size_t before = s21_bench::HeapInUse();
+  double insert_ms = s21_bench::Measure([&sets, &keys] {
+    for (int i = 0; i < kSets; ++i) {
+      for (int j = 0; j < kKeysPerSet; ++j) {
+        sets[i].insert(keys[i * kKeysPerSet + j]);
+      }
+    }
+  });
+  std::size_t bytes = s21_bench::HeapInUse() - before;
+
+  std::size_t hits = 0;
+  double find_ms = s21_bench::Measure([&sets, &keys, &hits] {
+    for (int i = 0; i < kSets; ++i) {
+      const Set &set = sets[i];
+      hits += set.find(keys[i * kKeysPerSet + i % kKeysPerSet]) != set.end();
+      hits += set.find(-1) != set.end();
+    }
+  });
+  s21_bench::DoNotOptimize(hits);
+  double destroy_ms = s21_bench::Measure([&sets] { sets = {}; });
+
+  std::size_t ops = std::size_t{kSets} * kKeysPerSet;
+  s21_bench::Report("tiny sets insert", container, ops, insert_ms);
+  s21_bench::Report("tiny sets contains", container, 2 * kSets, find_ms);
+  s21_bench::Report("tiny sets destroy", container, kSets, destroy_ms);
+  std::printf("%-28s %-16s %10zu bytes\n", "tiny sets heap", container,
+              bytes);
+}
+
+}  // namespace
+
+int main() {
+  std::vector<int> keys = s21_bench::RandomKeys(kSets * kKeysPerSet);
+  for (auto &key : keys) key %= 1000;
+  TinySets<s21::small_set<int>>("s21::small_set", keys);
+  TinySets<s21::set<int>>("s21::set", keys);
+  TinySets<std::set<int>>("std::set", keys);
+  return 0;
+}
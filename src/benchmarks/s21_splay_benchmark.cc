@@ -0,0 +1,83 @@
+// 1) Related header
+#include "components/s21_map.h"
+// 2) C system headers
+// 3) C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+// 4) other libraries' headers
+// 5) project's headers.
+#include "benchmarks/s21_benchmark.h"
+
+namespace {
+
+constexpr int kSize = 1000000;
+constexpr int kProbes = 4000000;
+
+using SplayMap = s21::map<int, int, std::less<int>, s21::HeapStorage,
+                          s21::SplayBalance>;
+
+// Probes drawn from a Zipf distribution with exponent skew over kSize keys.
+// Ranks are mapped through a random permutation so the hot keys are spread
+// over the whole key range instead of sitting next to each other.
+std::vector<int> ZipfProbes(double skew, unsigned seed) {
+  std::vector<double> cumulative(kSize);
+  double total = 0;
+  for (int rank = 0; rank < kSize; ++rank) {
+    total += 1.0 / std::pow(rank + 1, skew);
+    cumulative[rank] = total;
+  }
+  std::vector<int> permutation(kSize);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::mt19937 gen(seed);
+  std::shuffle(permutation.begin(), permutation.end(), gen);
+
+  std::uniform_real_distribution<double> dist(0, total);
+  std::vector<int> probes(kProbes);
+  for (auto &probe : probes) {
+    auto rank = std::upper_bound(cumulative.begin(), cumulative.end(),
+                                 dist(gen)) -
+                cumulative.begin();
+    probe = permutation[std::min<std::ptrdiff_t>(rank, kSize - 1)];
+  }
+  return probes;
+}
+
+// Keys are inserted in random order so every tree starts out with a
+// typical shape; a splay tree then reshapes itself around the hot keys
+template <typename Map>
+void Lookups(const char *name, const char *container,
+             const std::vector<int> &probes) {
+  std::vector<int> keys(kSize);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(5));
+  Map map;
+  for (int key : keys) map.insert({key, key});
+
+  std::size_t found = 0;
+  double ms = s21_bench::Measure([&map, &probes, &found] {
+    for (int probe : probes) found += map.find(probe) != map.end();
+  });
+  s21_bench::DoNotOptimize(found);
+  s21_bench::Report(name, container, probes.size(), ms);
+}
+
+}  // namespace
+
+// Skew 0 is uniform, where splaying only costs; from about 1 on a few
+// thousand keys take most of the lookups and stay near the root
+int main() {
+  for (double skew : {0.0, 0.8, 1.0, 1.2, 1.5}) {
+    std::vector<int> probes = ZipfProbes(skew, 11);
+    char name[48];
+    std::snprintf(name, sizeof(name), "zipf %.1f find", skew);
+    Lookups<s21::map<int, int>>(name, "s21::map", probes);
+    Lookups<SplayMap>(name, "s21::map splay", probes);
+    Lookups<std::map<int, int>>(name, "std::map", probes);
+  }
+  return 0;
+}
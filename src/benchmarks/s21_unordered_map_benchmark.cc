@@ -0,0 +1,96 @@
+// 1) Related header
+#include "components/s21_unordered_map.h"
+// 2) C system headers
+// 3) C++ standard library headers
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+// 4) other libraries' headers
+// 5) project's headers.
+#include "benchmarks/s21_benchmark.h"
+
+namespace {
+
+constexpr std::size_t kCount = 1000000;
+
+// Longest single insert while growing from empty: a rehash that moves
+// every entry at once shows up here
+template <typename Map, typename Key>
+double WorstInsertUs(const std::vector<Key> &keys) {
+  Map map;
+  double worst = 0;
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    auto start = std::chrono::steady_clock::now();
+    map[keys[i]] = static_cast<int>(i);
+    auto stop = std::chrono::steady_clock::now();
+    worst = std::max(
+        worst, std::chrono::duration<double, std::micro>(stop - start).count());
+  }
+  return worst;
+}
+
+// Fills a map from keys, probes it with probes (half of them misses) and
+// erases it again
+template <typename Map, typename Key>
+void Run(const char *name, const char *container, const std::vector<Key> &keys,
+         const std::vector<Key> &probes) {
+  Map map;
+  double insert_ms = s21_bench::Measure([&map, &keys] {
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      map[keys[i]] = static_cast<int>(i);
+    }
+  });
+  std::size_t hits = 0;
+  double find_ms = s21_bench::Measure([&map, &probes, &hits] {
+    for (const Key &key : probes) hits += map.find(key) != map.end();
+  });
+  s21_bench::DoNotOptimize(hits);
+  double erase_ms = s21_bench::Measure([&map, &keys] {
+    for (const Key &key : keys) map.erase(key);
+  });
+
+  std::string label(name);
+  s21_bench::Report((label + " insert").c_str(), container, keys.size(),
+                    insert_ms);
+  s21_bench::Report((label + " find").c_str(), container, probes.size(),
+                    find_ms);
+  s21_bench::Report((label + " erase").c_str(), container, keys.size(),
+                    erase_ms);
+  std::printf("%-28s %-16s %10.1f us\n", (label + " worst insert").c_str(),
+              container, WorstInsertUs<Map>(keys));
+}
+
+template <typename Key>
+std::vector<Key> Probes(const std::vector<Key> &keys,
+                        const std::vector<Key> &misses) {
+  std::vector<Key> probes;
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    probes.push_back(i % 2 == 0 ? keys[(i * 7919) % keys.size()] : misses[i]);
+  }
+  return probes;
+}
+
+}  // namespace
+
+int main() {
+  std::vector<int> keys = s21_bench::RandomKeys(kCount, 1);
+  std::vector<int> misses = s21_bench::RandomKeys(kCount, 2);
+  std::vector<int> probes = Probes(keys, misses);
+  Run<s21::unordered_map<int, int>>("int", "s21::unordered", keys, probes);
+  Run<std::unordered_map<int, int>>("int", "std::unordered", keys, probes);
+
+  std::vector<std::string> words;
+  std::vector<std::string> other_words;
+  for (std::size_t i = 0; i < kCount; ++i) {
+    words.push_back("word/" + std::to_string(keys[i]));
+    other_words.push_back("miss/" + std::to_string(misses[i]));
+  }
+  std::vector<std::string> word_probes = Probes(words, other_words);
+  Run<s21::unordered_map<std::string, int>>("string", "s21::unordered",
+                                            words, word_probes);
+  Run<std::unordered_map<std::string, int>>("string", "std::unordered",
+                                            words, word_probes);
+  return 0;
+}
@@ -0,0 +1,785 @@
+#ifndef COMPONENTS_S21_BTREE_H
+#define COMPONENTS_S21_BTREE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+
+namespace btree_detail {
+
+// What it->... exposes: the key, and the mapped value for maps. Keys and
+// values live in separate arrays of a leaf, so there is no node to point
+// at and the iterator hands out these references instead.
+template <typename Key, typename T>
+struct EntryRef {
+  const Key &key_;
+  const T &value_;
+};
+
+template <typename Key>
+struct EntryRef<Key, void> {
+  const Key &key_;
+};
+
+// Number of keys below key (kInclusive: not above it). keys is sorted, so
+// this is its lower (upper) bound. Every key is compared, there is no
+// early exit to mispredict, and the loop vectorizes.
+template <bool kInclusive, typename Key>
+std::size_t CountBelow(const Key *keys, std::size_t count, const Key &key) {
+  std::size_t below = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    below += kInclusive ? !(key < keys[i]) : keys[i] < key;
+  }
+  return below;
+}
+
+#if defined(__SSE2__)
+// The same for the common 32-bit keys, four compares at a time
+template <bool kInclusive>
+std::size_t CountBelow(const int *keys, std::size_t count, const int &key) {
+  const __m128i needle = _mm_set1_epi32(key);
+  std::size_t below = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+    __m128i hits = kInclusive ? _mm_cmpgt_epi32(block, needle)
+                              : _mm_cmplt_epi32(block, needle);
+    int bits = __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(hits)));
+    below += kInclusive ? 4 - bits : bits;
+  }
+  for (; i < count; ++i) below += kInclusive ? !(key < keys[i]) : keys[i] < key;
+  return below;
+}
+
+template <bool kInclusive>
+std::size_t CountBelow(const float *keys, std::size_t count,
+                       const float &key) {
+  const __m128 needle = _mm_set1_ps(key);
+  std::size_t below = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 block = _mm_loadu_ps(keys + i);
+    __m128 hits = kInclusive ? _mm_cmple_ps(block, needle)
+                             : _mm_cmplt_ps(block, needle);
+    below += __builtin_popcount(_mm_movemask_ps(hits));
+  }
+  for (; i < count; ++i) below += kInclusive ? !(key < keys[i]) : keys[i] < key;
+  return below;
+}
+#endif
+
+// Counting every key stops paying off past this many
+constexpr std::size_t kCountedKeys = 32;
+
+// CountBelow for nodes of any size: branch free halving narrows a large
+// node down to kCountedKeys candidates, which are then counted
+template <bool kInclusive, typename Key>
+std::size_t Bound(const Key *keys, std::size_t count, const Key &key) {
+  std::size_t base = 0;
+  while (count > kCountedKeys) {
+    std::size_t half = count / 2;
+    const Key &middle = keys[base + half];
+    base = (kInclusive ? !(key < middle) : middle < key) ? base + half : base;
+    count -= half;
+  }
+  return base + CountBelow<kInclusive>(keys + base, count, key);
+}
+
+}  // namespace btree_detail
+
+/**
+ * Shared part of btree_set and btree_map: a B+ tree whose nodes are about
+ * NodeBytes large and hold many sorted keys each. Every entry lives in a
+ * leaf; inner nodes only hold copies of keys that route a search, and the
+ * leaves are chained for iteration. A lookup touches a handful of nodes
+ * instead of the ~log2(n) scattered nodes of a binary tree, and per entry
+ * there is no pointer or colour overhead, only the unused slots.
+ *
+ * In-node search counts the smaller keys without branching when Key is
+ * arithmetic and Compare is std::less (with SSE2 compares for int and
+ * float), after branch free halving for page sized nodes, and is a binary
+ * search with Compare otherwise.
+ *
+ * Key and T must be default constructible and move assignable, as slots
+ * are plain arrays. Unlike s21::set / s21::map iterators, any insert or
+ * erase invalidates every iterator, since entries move between slots.
+ */
+template <typename Key, typename T, typename Compare, std::size_t NodeBytes>
+class BTree {
+ public:
+  using size_type = std::size_t;
+  using Entry = btree_detail::EntryRef<Key, T>;
+
+ private:
+  using Mapped = std::conditional_t<std::is_void_v<T>, char, T>;
+  static constexpr size_type kValueBytes =
+      std::is_void_v<T> ? 0 : sizeof(Mapped);
+  static constexpr size_type kLeafSlots =
+      std::max<size_type>(4, NodeBytes / (sizeof(Key) + kValueBytes));
+  static constexpr size_type kInnerSlots =
+      std::max<size_type>(4, NodeBytes / (sizeof(Key) + sizeof(void *)));
+  static constexpr bool kBranchFree =
+      std::is_arithmetic_v<Key> && std::is_same_v<Compare, std::less<Key>>;
+
+  struct NoValues {};
+  using Values = std::conditional_t<std::is_void_v<T>, NoValues,
+                                    std::array<Mapped, kLeafSlots>>;
+
+  struct Node {
+    explicit Node(bool leaf) : leaf_(leaf) {}
+    bool leaf_;
+    size_type count_ = 0;
+  };
+
+  struct Leaf : Node {
+    Leaf() : Node(true) {}
+    Key keys_[kLeafSlots]{};
+    Values values_{};
+    Leaf *prev_ = nullptr;
+    Leaf *next_ = nullptr;
+  };
+
+  // Child i holds the keys k with keys_[i - 1] <= k < keys_[i]
+  struct Inner : Node {
+    Inner() : Node(false) {}
+    Key keys_[kInnerSlots]{};
+    Node *children_[kInnerSlots + 1]{};
+  };
+
+  // The ends of the leaf chain, for begin() and --end()
+  struct Header {
+    Leaf *leftmost_ = nullptr;
+    Leaf *rightmost_ = nullptr;
+  };
+
+  // A new right sibling, and the key that separates it from the left one
+  struct Split {
+    Key separator_{};
+    Node *right_ = nullptr;
+  };
+
+ public:
+  class const_iterator {
+   private:
+    const Leaf *leaf_ = nullptr;  // null at end()
+    size_type index_ = 0;
+    const Header *header_ = nullptr;
+    friend class BTree;
+
+    const_iterator(const Leaf *leaf, size_type index, const Header *header)
+        : leaf_(leaf), index_(index), header_(header) {}
+
+    // Keeps Entry alive for the duration of it->...
+    class Arrow {
+     public:
+      explicit Arrow(const Entry &entry) : entry_(entry) {}
+      const Entry *operator->() const { return &entry_; }
+
+     private:
+      Entry entry_;
+    };
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Arrow;
+    using reference = const Key &;
+
+    const_iterator() = default;
+
+    const Key &operator*() const { return leaf_->keys_[index_]; }
+    Arrow operator->() const {
+      if constexpr (std::is_void_v<T>) {
+        return Arrow(Entry{leaf_->keys_[index_]});
+      } else {
+        return Arrow(Entry{leaf_->keys_[index_], leaf_->values_[index_]});
+      }
+    }
+
+    const_iterator &operator++() {
+      if (++index_ == leaf_->count_) {
+        leaf_ = leaf_->next_;
+        index_ = 0;
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+    const_iterator &operator--() {
+      if (leaf_ == nullptr) {
+        leaf_ = header_->rightmost_;
+        index_ = leaf_->count_ - 1;
+      } else if (index_ == 0) {
+        leaf_ = leaf_->prev_;
+        index_ = leaf_->count_ - 1;
+      } else {
+        --index_;
+      }
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator tmp(*this);
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return leaf_ == other.leaf_ && index_ == other.index_;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+  };  // end class const_iterator
+
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  BTree() = default;
+  explicit BTree(const Compare &compare) : compare_(compare) {}
+  BTree(const BTree &other) : compare_(other.compare_) { CopyFrom(other); }
+  BTree(BTree &&other) noexcept { swap(other); }
+  ~BTree() { clear(); }
+
+  BTree &operator=(const BTree &other) {
+    if (this != &other) {
+      BTree copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  BTree &operator=(BTree &&other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  const_iterator begin() const {
+    return const_iterator(header_.leftmost_, 0, &header_);
+  }
+  const_iterator end() const { return const_iterator(nullptr, 0, &header_); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void clear() {
+    Destroy(root_);
+    root_ = nullptr;
+    header_ = Header();
+    size_ = 0;
+  }
+
+  void swap(BTree &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(header_, other.header_);
+    std::swap(size_, other.size_);
+    std::swap(compare_, other.compare_);
+  }
+
+  const_iterator find(const Key &key) const {
+    const_iterator it = lower_bound(key);
+    return it != end() && !compare_(key, *it) ? it : end();
+  }
+
+  bool contains(const Key &key) const { return find(key) != end(); }
+
+  const_iterator lower_bound(const Key &key) const {
+    if (root_ == nullptr) return end();
+    const Leaf *leaf = FindLeaf(key);
+    return Position(leaf, LowerIndex(leaf->keys_, leaf->count_, key));
+  }
+
+  const_iterator upper_bound(const Key &key) const {
+    if (root_ == nullptr) return end();
+    const Leaf *leaf = FindLeaf(key);
+    return Position(leaf, UpperIndex(leaf->keys_, leaf->count_, key));
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key &key) const {
+    const_iterator first = lower_bound(key);
+    const_iterator last = first;
+    if (last != end() && !compare_(key, *last)) ++last;
+    return {first, last};
+  }
+
+  // Returns the entry that followed pos
+  const_iterator erase(const_iterator pos) {
+    Leaf *leaf = const_cast<Leaf *>(pos.leaf_);
+    if (leaf == root_ || leaf->count_ > MinCount(leaf)) {
+      // No underflow, nothing else moves
+      RemoveEntry(leaf, pos.index_);
+      --size_;
+      if (leaf->count_ == 0) {
+        clear();
+        return end();
+      }
+      return Position(leaf, pos.index_);
+    }
+    // Rebalancing shifts entries between leaves, so the follower is found
+    // again by its key
+    const_iterator next = std::next(pos);
+    if (next == end()) {
+      EraseKey(Key(*pos));
+      return end();
+    }
+    Key follower = *next;
+    EraseKey(Key(*pos));
+    return lower_bound(follower);
+  }
+
+  const_iterator erase(const_iterator first, const_iterator last) {
+    if (last == end()) {
+      while (first != end()) first = erase(first);
+      return end();
+    }
+    // erase() invalidates last, its key stays valid
+    Key stop = *last;
+    while (first != end() && compare_(*first, stop)) first = erase(first);
+    return first;
+  }
+
+  size_type erase(const Key &key) { return EraseKey(key); }
+
+  Compare key_comp() const { return compare_; }
+
+ protected:
+  // Builds the entry from key and args unless key is already present
+  template <typename... Args>
+  std::pair<const_iterator, bool> Emplace(const Key &key, Args &&...args) {
+    if (root_ == nullptr) {
+      Leaf *leaf = new Leaf();
+      root_ = leaf;
+      header_ = Header{leaf, leaf};
+    }
+    const Leaf *where = nullptr;
+    size_type index = 0;
+    bool inserted = false;
+    Split split = InsertInto(root_, key, where, index, inserted,
+                             std::forward<Args>(args)...);
+    if (split.right_ != nullptr) {
+      Inner *root = new Inner();
+      root->count_ = 1;
+      root->keys_[0] = std::move(split.separator_);
+      root->children_[0] = root_;
+      root->children_[1] = split.right_;
+      root_ = root;
+    }
+    size_ += inserted;
+    return {const_iterator(where, index, &header_), inserted};
+  }
+
+ private:
+  static size_type MinCount(const Node *node) {
+    return (node->leaf_ ? kLeafSlots : kInnerSlots) / 2;
+  }
+
+  size_type LowerIndex(const Key *keys, size_type count,
+                       const Key &key) const {
+    if constexpr (kBranchFree) {
+      return btree_detail::Bound<false>(keys, count, key);
+    } else {
+      return std::lower_bound(keys, keys + count, key, compare_) - keys;
+    }
+  }
+
+  size_type UpperIndex(const Key *keys, size_type count,
+                       const Key &key) const {
+    if constexpr (kBranchFree) {
+      return btree_detail::Bound<true>(keys, count, key);
+    } else {
+      return std::upper_bound(keys, keys + count, key, compare_) - keys;
+    }
+  }
+
+  // The leaf key belongs in
+  const Leaf *FindLeaf(const Key &key) const {
+    const Node *node = root_;
+    while (!node->leaf_) {
+      const Inner *inner = static_cast<const Inner *>(node);
+      node = inner->children_[UpperIndex(inner->keys_, inner->count_, key)];
+    }
+    return static_cast<const Leaf *>(node);
+  }
+
+  // Slot index of leaf, or the first slot of the next leaf past its end
+  const_iterator Position(const Leaf *leaf, size_type index) const {
+    if (index == leaf->count_) return const_iterator(leaf->next_, 0, &header_);
+    return const_iterator(leaf, index, &header_);
+  }
+
+  template <typename... Args>
+  static Mapped MakeValue(Args &&...args) {
+    if constexpr (sizeof...(Args) == 0) {
+      return Mapped();
+    } else {
+      return Mapped(std::forward<Args>(args)...);
+    }
+  }
+
+  static void MoveEntry(Leaf *from, size_type from_index, Leaf *to,
+                        size_type to_index) {
+    to->keys_[to_index] = std::move(from->keys_[from_index]);
+    if constexpr (!std::is_void_v<T>) {
+      to->values_[to_index] = std::move(from->values_[from_index]);
+    }
+  }
+
+  // Opens slot index, the leaf must have room
+  static void OpenSlot(Leaf *leaf, size_type index) {
+    for (size_type i = leaf->count_; i > index; --i) {
+      MoveEntry(leaf, i - 1, leaf, i);
+    }
+    ++leaf->count_;
+  }
+
+  static void RemoveEntry(Leaf *leaf, size_type index) {
+    for (size_type i = index + 1; i < leaf->count_; ++i) {
+      MoveEntry(leaf, i, leaf, i - 1);
+    }
+    --leaf->count_;
+  }
+
+  template <typename... Args>
+  Split InsertInto(Node *node, const Key &key, const Leaf *&where,
+                   size_type &index, bool &inserted, Args &&...args) {
+    if (node->leaf_) {
+      return InsertIntoLeaf(static_cast<Leaf *>(node), key, where, index,
+                            inserted, std::forward<Args>(args)...);
+    }
+    Inner *inner = static_cast<Inner *>(node);
+    size_type child = UpperIndex(inner->keys_, inner->count_, key);
+    Split split = InsertInto(inner->children_[child], key, where, index,
+                             inserted, std::forward<Args>(args)...);
+    if (split.right_ == nullptr) return Split();
+    return InsertChild(inner, child, std::move(split));
+  }
+
+  template <typename... Args>
+  Split InsertIntoLeaf(Leaf *leaf, const Key &key, const Leaf *&where,
+                       size_type &index, bool &inserted, Args &&...args) {
+    size_type position = LowerIndex(leaf->keys_, leaf->count_, key);
+    where = leaf;
+    index = position;
+    if (position < leaf->count_ && !compare_(key, leaf->keys_[position])) {
+      return Split();
+    }
+    // Built first so a throwing constructor leaves the leaf untouched
+    Mapped value = MakeValue(std::forward<Args>(args)...);
+    inserted = true;
+    Split split;
+    if (leaf->count_ == kLeafSlots) {
+      // The lower half stays, the upper half moves to a new right sibling
+      Leaf *right = new Leaf();
+      size_type keep = (kLeafSlots + 1) / 2;
+      if (position < keep) --keep;
+      for (size_type i = keep; i < kLeafSlots; ++i) {
+        MoveEntry(leaf, i, right, i - keep);
+      }
+      right->count_ = kLeafSlots - keep;
+      leaf->count_ = keep;
+      right->prev_ = leaf;
+      right->next_ = leaf->next_;
+      if (leaf->next_ != nullptr) {
+        leaf->next_->prev_ = right;
+      } else {
+        header_.rightmost_ = right;
+      }
+      leaf->next_ = right;
+      if (position > keep) {
+        where = right;
+        index = position - keep;
+      }
+      split.right_ = right;
+    }
+    Leaf *target = const_cast<Leaf *>(where);
+    OpenSlot(target, index);
+    target->keys_[index] = key;
+    if constexpr (!std::is_void_v<T>) target->values_[index] = std::move(value);
+    if (split.right_ != nullptr) {
+      split.separator_ = static_cast<Leaf *>(split.right_)->keys_[0];
+    }
+    return split;
+  }
+
+  // Adds split.right_ as child child + 1 of inner, splitting inner in turn
+  // if it is full
+  Split InsertChild(Inner *inner, size_type child, Split split) {
+    if (inner->count_ < kInnerSlots) {
+      for (size_type i = inner->count_; i > child; --i) {
+        inner->keys_[i] = std::move(inner->keys_[i - 1]);
+        inner->children_[i + 1] = inner->children_[i];
+      }
+      inner->keys_[child] = std::move(split.separator_);
+      inner->children_[child + 1] = split.right_;
+      ++inner->count_;
+      return Split();
+    }
+    // Lay out all kInnerSlots + 1 keys, then the middle one moves up
+    Key keys[kInnerSlots + 1];
+    Node *children[kInnerSlots + 2];
+    for (size_type i = 0, from = 0; i <= kInnerSlots; ++i) {
+      keys[i] = i == child ? std::move(split.separator_)
+                           : std::move(inner->keys_[from++]);
+    }
+    for (size_type i = 0, from = 0; i <= kInnerSlots + 1; ++i) {
+      children[i] = i == child + 1 ? split.right_ : inner->children_[from++];
+    }
+    size_type keep = (kInnerSlots + 1) / 2;
+    Inner *right = new Inner();
+    for (size_type i = 0; i < keep; ++i) {
+      inner->keys_[i] = std::move(keys[i]);
+    }
+    for (size_type i = 0; i <= keep; ++i) inner->children_[i] = children[i];
+    inner->count_ = keep;
+    right->count_ = kInnerSlots - keep;
+    for (size_type i = 0; i < right->count_; ++i) {
+      right->keys_[i] = std::move(keys[keep + 1 + i]);
+    }
+    for (size_type i = 0; i <= right->count_; ++i) {
+      right->children_[i] = children[keep + 1 + i];
+    }
+    return Split{std::move(keys[keep]), right};
+  }
+
+  size_type EraseKey(const Key &key) {
+    if (root_ == nullptr || !EraseFrom(root_, key)) return 0;
+    --size_;
+    if (root_->count_ == 0) {
+      if (root_->leaf_) {
+        clear();
+      } else {
+        Inner *root = static_cast<Inner *>(root_);
+        root_ = root->children_[0];
+        delete root;
+      }
+    }
+    return 1;
+  }
+
+  // Separators are left alone when a leaf loses its first key: they only
+  // need to keep the subtrees apart, not to equal a present key
+  bool EraseFrom(Node *node, const Key &key) {
+    if (node->leaf_) {
+      Leaf *leaf = static_cast<Leaf *>(node);
+      size_type position = LowerIndex(leaf->keys_, leaf->count_, key);
+      if (position == leaf->count_ || compare_(key, leaf->keys_[position])) {
+        return false;
+      }
+      RemoveEntry(leaf, position);
+      return true;
+    }
+    Inner *inner = static_cast<Inner *>(node);
+    size_type child = UpperIndex(inner->keys_, inner->count_, key);
+    if (!EraseFrom(inner->children_[child], key)) return false;
+    if (inner->children_[child]->count_ < MinCount(inner->children_[child])) {
+      Rebalance(inner, child);
+    }
+    return true;
+  }
+
+  // Refills child i of parent, which fell below the minimum, from a
+  // sibling with entries to spare, or else merges it with one
+  void Rebalance(Inner *parent, size_type i) {
+    Node *left = i > 0 ? parent->children_[i - 1] : nullptr;
+    Node *right = i < parent->count_ ? parent->children_[i + 1] : nullptr;
+    if (left != nullptr && left->count_ > MinCount(left)) {
+      BorrowFromLeft(parent, i);
+    } else if (right != nullptr && right->count_ > MinCount(right)) {
+      BorrowFromRight(parent, i);
+    } else {
+      Merge(parent, left != nullptr ? i - 1 : i);
+    }
+  }
+
+  void BorrowFromLeft(Inner *parent, size_type i) {
+    Node *child = parent->children_[i];
+    if (child->leaf_) {
+      Leaf *to = static_cast<Leaf *>(child);
+      Leaf *from = static_cast<Leaf *>(parent->children_[i - 1]);
+      OpenSlot(to, 0);
+      MoveEntry(from, --from->count_, to, 0);
+      parent->keys_[i - 1] = to->keys_[0];
+      return;
+    }
+    Inner *to = static_cast<Inner *>(child);
+    Inner *from = static_cast<Inner *>(parent->children_[i - 1]);
+    for (size_type j = to->count_; j > 0; --j) {
+      to->keys_[j] = std::move(to->keys_[j - 1]);
+      to->children_[j + 1] = to->children_[j];
+    }
+    to->children_[1] = to->children_[0];
+    to->keys_[0] = std::move(parent->keys_[i - 1]);
+    to->children_[0] = from->children_[from->count_];
+    ++to->count_;
+    parent->keys_[i - 1] = std::move(from->keys_[--from->count_]);
+  }
+
+  void BorrowFromRight(Inner *parent, size_type i) {
+    Node *child = parent->children_[i];
+    if (child->leaf_) {
+      Leaf *to = static_cast<Leaf *>(child);
+      Leaf *from = static_cast<Leaf *>(parent->children_[i + 1]);
+      MoveEntry(from, 0, to, to->count_++);
+      RemoveEntry(from, 0);
+      parent->keys_[i] = from->keys_[0];
+      return;
+    }
+    Inner *to = static_cast<Inner *>(child);
+    Inner *from = static_cast<Inner *>(parent->children_[i + 1]);
+    to->keys_[to->count_] = std::move(parent->keys_[i]);
+    to->children_[++to->count_] = from->children_[0];
+    parent->keys_[i] = std::move(from->keys_[0]);
+    for (size_type j = 1; j < from->count_; ++j) {
+      from->keys_[j - 1] = std::move(from->keys_[j]);
+    }
+    for (size_type j = 1; j <= from->count_; ++j) {
+      from->children_[j - 1] = from->children_[j];
+    }
+    --from->count_;
+  }
+
+  // Moves child i + 1 of parent into child i and drops separator i
+  void Merge(Inner *parent, size_type i) {
+    Node *left = parent->children_[i];
+    Node *right = parent->children_[i + 1];
+    if (left->leaf_) {
+      Leaf *to = static_cast<Leaf *>(left);
+      Leaf *from = static_cast<Leaf *>(right);
+      for (size_type j = 0; j < from->count_; ++j) {
+        MoveEntry(from, j, to, to->count_ + j);
+      }
+      to->count_ += from->count_;
+      to->next_ = from->next_;
+      if (from->next_ != nullptr) {
+        from->next_->prev_ = to;
+      } else {
+        header_.rightmost_ = to;
+      }
+      delete from;
+    } else {
+      Inner *to = static_cast<Inner *>(left);
+      Inner *from = static_cast<Inner *>(right);
+      to->keys_[to->count_] = std::move(parent->keys_[i]);
+      for (size_type j = 0; j < from->count_; ++j) {
+        to->keys_[to->count_ + 1 + j] = std::move(from->keys_[j]);
+      }
+      for (size_type j = 0; j <= from->count_; ++j) {
+        to->children_[to->count_ + 1 + j] = from->children_[j];
+      }
+      to->count_ += from->count_ + 1;
+      delete from;
+    }
+    for (size_type j = i + 1; j < parent->count_; ++j) {
+      parent->keys_[j - 1] = std::move(parent->keys_[j]);
+      parent->children_[j] = parent->children_[j + 1];
+    }
+    --parent->count_;
+  }
+
+  void CopyFrom(const BTree &other) {
+    if (other.root_ == nullptr) return;
+    Leaf *previous = nullptr;
+    try {
+      root_ = CopyNode(other.root_, previous);
+    } catch (...) {
+      // Leaves copied so far are chained from leftmost_
+      for (Leaf *leaf = header_.leftmost_; leaf != nullptr;) {
+        Leaf *next = leaf->next_;
+        delete leaf;
+        leaf = next;
+      }
+      header_ = Header();
+      throw;
+    }
+    header_.rightmost_ = previous;
+    size_ = other.size_;
+  }
+
+  // Copies the subtree in key order, chaining each copied leaf after
+  // previous. On a throw the inner nodes copied so far are freed here.
+  Node *CopyNode(const Node *node, Leaf *&previous) {
+    if (node->leaf_) {
+      Leaf *copy = new Leaf(*static_cast<const Leaf *>(node));
+      copy->prev_ = previous;
+      copy->next_ = nullptr;
+      if (previous != nullptr) {
+        previous->next_ = copy;
+      } else {
+        header_.leftmost_ = copy;
+      }
+      previous = copy;
+      return copy;
+    }
+    const Inner *inner = static_cast<const Inner *>(node);
+    Inner *copy = new Inner();
+    try {
+      for (size_type i = 0; i < inner->count_; ++i) {
+        copy->keys_[i] = inner->keys_[i];
+      }
+      for (size_type i = 0; i <= inner->count_; ++i) {
+        copy->children_[i] = CopyNode(inner->children_[i], previous);
+        copy->count_ = i;
+      }
+    } catch (...) {
+      DestroyInner(copy);
+      throw;
+    }
+    copy->count_ = inner->count_;
+    return copy;
+  }
+
+  // Frees the inner nodes of a partial copy, whose leaves are freed
+  // through the chain; count_ is one less than the copied children
+  static void DestroyInner(Inner *inner) {
+    for (size_type i = 0; i <= inner->count_ && inner->children_[i]; ++i) {
+      if (!inner->children_[i]->leaf_) {
+        DestroyInner(static_cast<Inner *>(inner->children_[i]));
+      }
+    }
+    delete inner;
+  }
+
+  static void Destroy(Node *node) {
+    if (node == nullptr) return;
+    if (node->leaf_) {
+      delete static_cast<Leaf *>(node);
+      return;
+    }
+    Inner *inner = static_cast<Inner *>(node);
+    for (size_type i = 0; i <= inner->count_; ++i) {
+      Destroy(inner->children_[i]);
+    }
+    delete inner;
+  }
+
+  Node *root_ = nullptr;
+  Header header_;
+  size_type size_ = 0;
+  Compare compare_;
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_BTREE_H
@@ -0,0 +1,41 @@
+#ifndef COMPONENTS_S21_BTREE_SET_H
+#define COMPONENTS_S21_BTREE_SET_H
+
+#include <initializer_list>
+
+#include "s21_btree.h"
+
+namespace s21 {
+/**
+ * Set kept in a B+ tree of NodeBytes sized nodes (see BTree). Iterators
+ * and lower_bound behave like s21::set ones, so the two can be swapped
+ * with a using, except that inserting or erasing invalidates iterators.
+ */
+template <typename Key, typename Compare = std::less<Key>,
+          std::size_t NodeBytes = 256>
+class btree_set : public BTree<Key, void, Compare, NodeBytes> {
+ private:
+  using Base = BTree<Key, void, Compare, NodeBytes>;
+  using key_type = Key;
+  using value_type = Key;
+  using const_iterator = typename Base::const_iterator;
+
+ public:
+  btree_set() = default;
+  explicit btree_set(const Compare &compare) : Base(compare) {}
+  btree_set(std::initializer_list<value_type> const &items)
+      : btree_set(items.begin(), items.end()) {}
+  template <typename InputIt>
+  btree_set(InputIt first, InputIt last, const Compare &compare = Compare())
+      : Base(compare) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  std::pair<const_iterator, bool> insert(const value_type &value) {
+    return this->Emplace(value);
+  }
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_BTREE_SET_H
@@ -0,0 +1,411 @@
+#ifndef COMPONENTS_S21_FLAT_CONTAINER_H
+#define COMPONENTS_S21_FLAT_CONTAINER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+namespace flat_detail {
+
+// What it->... exposes: the key, and the mapped value for maps, which sit
+// at the same index of two separate arrays
+template <typename Key, typename T>
+struct EntryRef {
+  const Key &key_;
+  const T &value_;
+};
+
+template <typename Key>
+struct EntryRef<Key, void> {
+  const Key &key_;
+};
+
+}  // namespace flat_detail
+
+/**
+ * Shared part of flat_set and flat_map: the keys in one sorted s21::vector
+ * and, for maps, the mapped values at the same indices of a second one.
+ * Lookups are binary searches over contiguous keys, and a full iteration
+ * is a linear scan of memory, with no per-entry allocation or pointers.
+ *
+ * A single insert or erase shifts the entries behind it, O(n). Loading
+ * many entries should go through insert(first, last), which sorts the
+ * batch and merges it in with one backward pass, in place when capacity
+ * allows. Any insert or erase invalidates iterators.
+ *
+ * Key and T must be default constructible, as s21::vector requires.
+ */
+template <typename Key, typename T, typename Compare>
+class FlatSortedContainer {
+ public:
+  using size_type = std::size_t;
+  using Entry = flat_detail::EntryRef<Key, T>;
+
+ private:
+  using Mapped = std::conditional_t<std::is_void_v<T>, char, T>;
+  struct NoValues {};
+  using Values =
+      std::conditional_t<std::is_void_v<T>, NoValues, vector<Mapped>>;
+  // An entry of insert(first, last) while it is sorted
+  using Staged =
+      std::conditional_t<std::is_void_v<T>, Key, std::pair<Key, Mapped>>;
+
+ public:
+  class const_iterator {
+   private:
+    const Key *key_ = nullptr;
+    const Mapped *value_ = nullptr;  // null for sets
+    friend class FlatSortedContainer;
+
+    const_iterator(const Key *key, const Mapped *value)
+        : key_(key), value_(value) {}
+
+    // Keeps Entry alive for the duration of it->...
+    class Arrow {
+     public:
+      explicit Arrow(const Entry &entry) : entry_(entry) {}
+      const Entry *operator->() const { return &entry_; }
+
+     private:
+      Entry entry_;
+    };
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Arrow;
+    using reference = const Key &;
+
+    const_iterator() = default;
+
+    const Key &operator*() const { return *key_; }
+    Arrow operator->() const {
+      if constexpr (std::is_void_v<T>) {
+        return Arrow(Entry{*key_});
+      } else {
+        return Arrow(Entry{*key_, *value_});
+      }
+    }
+
+    const_iterator &operator++() {
+      ++key_;
+      if constexpr (!std::is_void_v<T>) ++value_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+    const_iterator &operator--() {
+      --key_;
+      if constexpr (!std::is_void_v<T>) --value_;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator tmp(*this);
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return key_ == other.key_;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return key_ != other.key_;
+    }
+  };  // end class const_iterator
+
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  FlatSortedContainer() = default;
+  explicit FlatSortedContainer(const Compare &compare) : compare_(compare) {}
+  FlatSortedContainer(const FlatSortedContainer &other) = default;
+  FlatSortedContainer(FlatSortedContainer &&other) noexcept
+      : keys_(std::move(other.keys_)),
+        values_(std::move(other.values_)),
+        compare_(other.compare_) {}
+
+  // s21::vector has no copy assignment, so copy and swap
+  FlatSortedContainer &operator=(const FlatSortedContainer &other) {
+    if (this != &other) {
+      FlatSortedContainer copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  FlatSortedContainer &operator=(FlatSortedContainer &&other) noexcept {
+    if (this != &other) {
+      FlatSortedContainer moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  const_iterator begin() const { return At(0); }
+  const_iterator end() const { return At(size()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const { return keys_.size(); }
+  bool empty() const { return keys_.empty(); }
+  size_type capacity() const { return keys_.capacity(); }
+
+  // Room for count entries without reallocating
+  void reserve(size_type count) {
+    keys_.reserve(count);
+    if constexpr (!std::is_void_v<T>) values_.reserve(count);
+  }
+
+  void shrink_to_fit() {
+    keys_.shrink_to_fit();
+    if constexpr (!std::is_void_v<T>) values_.shrink_to_fit();
+  }
+
+  void clear() {
+    keys_.clear();
+    if constexpr (!std::is_void_v<T>) values_.clear();
+  }
+
+  void swap(FlatSortedContainer &other) noexcept {
+    keys_.swap(other.keys_);
+    if constexpr (!std::is_void_v<T>) values_.swap(other.values_);
+    std::swap(compare_, other.compare_);
+  }
+
+  const_iterator find(const Key &key) const {
+    size_type index = LowerBound(key);
+    return HoldsKey(index, key) ? At(index) : end();
+  }
+
+  bool contains(const Key &key) const {
+    return HoldsKey(LowerBound(key), key);
+  }
+
+  const_iterator lower_bound(const Key &key) const {
+    return At(LowerBound(key));
+  }
+  const_iterator upper_bound(const Key &key) const {
+    return At(UpperBound(key));
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key &key) const {
+    size_type index = LowerBound(key);
+    return {At(index), At(index + HoldsKey(index, key))};
+  }
+
+  // Returns the entry that followed pos
+  const_iterator erase(const_iterator pos) { return erase(pos, Next(pos)); }
+
+  const_iterator erase(const_iterator first, const_iterator last) {
+    size_type from = IndexOf(first);
+    EraseSlots(from, IndexOf(last));
+    return At(from);
+  }
+
+  size_type erase(const Key &key) {
+    size_type index = LowerBound(key);
+    if (!HoldsKey(index, key)) return 0;
+    EraseSlots(index, index + 1);
+    return 1;
+  }
+
+  Compare key_comp() const { return compare_; }
+
+ protected:
+  // Builds the entry from key and args unless key is already present
+  template <typename... Args>
+  std::pair<const_iterator, bool> Emplace(const Key &key, Args &&...args) {
+    size_type index = LowerBound(key);
+    if (HoldsKey(index, key)) return {At(index), false};
+    // Everything that may throw comes first: the copies, growing both
+    // arrays to the same capacity and a free slot at the end of each.
+    // Then the entries are only moved, as in EraseSlots.
+    Key new_key(key);
+    Mapped value = MakeValue(std::forward<Args>(args)...);
+    reserve(size() == capacity() ? std::max<size_type>(1, 2 * size())
+                                 : capacity());
+    keys_.push_back(Key());
+    if constexpr (!std::is_void_v<T>) {
+      try {
+        values_.push_back(Mapped());
+      } catch (...) {
+        keys_.pop_back();
+        throw;
+      }
+      std::move_backward(values_.begin() + index, values_.end() - 1,
+                         values_.end());
+      values_[index] = std::move(value);
+    }
+    std::move_backward(keys_.begin() + index, keys_.end() - 1, keys_.end());
+    keys_[index] = std::move(new_key);
+    return {At(index), true};
+  }
+
+  // Adds [first, last) in one merge. The batch is stable sorted, so of
+  // repeated keys the first one wins; keys already present are kept.
+  template <typename InputIt>
+  void InsertRange(InputIt first, InputIt last) {
+    std::vector<Staged> batch;
+    for (; first != last; ++first) {
+      if constexpr (std::is_void_v<T>) {
+        batch.push_back(*first);
+      } else {
+        batch.emplace_back(first->first, first->second);
+      }
+    }
+    std::stable_sort(batch.begin(), batch.end(),
+                     [this](const Staged &left, const Staged &right) {
+                       return compare_(KeyOf(left), KeyOf(right));
+                     });
+    // Drop repeats and present keys, so the merged size is known up front
+    auto fresh_end = std::unique(batch.begin(), batch.end(),
+                                 [this](const Staged &left,
+                                        const Staged &right) {
+                                   return !compare_(KeyOf(left), KeyOf(right));
+                                 });
+    fresh_end = std::remove_if(
+        batch.begin(), fresh_end,
+        [this](const Staged &staged) { return contains(KeyOf(staged)); });
+    MergeBack(batch.data(), fresh_end - batch.begin());
+  }
+
+ private:
+  static const Key &KeyOf(const Staged &staged) {
+    if constexpr (std::is_void_v<T>) {
+      return staged;
+    } else {
+      return staged.first;
+    }
+  }
+
+  template <typename... Args>
+  static Mapped MakeValue(Args &&...args) {
+    if constexpr (sizeof...(Args) == 0) {
+      return Mapped();
+    } else {
+      return Mapped(std::forward<Args>(args)...);
+    }
+  }
+
+  const_iterator At(size_type index) const {
+    if constexpr (std::is_void_v<T>) {
+      return const_iterator(keys_.cbegin() + index, nullptr);
+    } else {
+      return const_iterator(keys_.cbegin() + index, values_.cbegin() + index);
+    }
+  }
+
+  size_type IndexOf(const_iterator it) const {
+    return it.key_ - keys_.cbegin();
+  }
+
+  static const_iterator Next(const_iterator it) { return ++it; }
+
+  // Branch free binary search: the halving picks the next range with a
+  // conditional move rather than a jump, so a lookup has no mispredictions
+  // and its loads are independent of the comparison outcomes
+  size_type LowerBound(const Key &key) const {
+    const Key *base = keys_.cbegin();
+    size_type count = keys_.size();
+    while (count > 1) {
+      size_type half = count / 2;
+      base = compare_(base[half], key) ? base + half : base;
+      count -= half;
+    }
+    return base - keys_.cbegin() + (count == 1 && compare_(*base, key));
+  }
+
+  size_type UpperBound(const Key &key) const {
+    const Key *base = keys_.cbegin();
+    size_type count = keys_.size();
+    while (count > 1) {
+      size_type half = count / 2;
+      base = compare_(key, base[half]) ? base : base + half;
+      count -= half;
+    }
+    return base - keys_.cbegin() + (count == 1 && !compare_(key, *base));
+  }
+
+  bool HoldsKey(size_type index, const Key &key) const {
+    return index < size() && !compare_(key, keys_.cbegin()[index]);
+  }
+
+  // Moves the entries behind [from, to) down over it. The vacated tail
+  // slots are reset so they hold on to no resources, from the back, so
+  // each one is still the last live entry when it is reset and popped.
+  void EraseSlots(size_type from, size_type to) {
+    size_type count = size();
+    for (size_type i = to; i < count; ++i) {
+      keys_[i - (to - from)] = std::move(keys_[i]);
+      if constexpr (!std::is_void_v<T>) {
+        values_[i - (to - from)] = std::move(values_[i]);
+      }
+    }
+    for (size_type i = count; i > count - (to - from); --i) {
+      keys_[i - 1] = Key();
+      keys_.pop_back();
+      if constexpr (!std::is_void_v<T>) {
+        values_[i - 1] = Mapped();
+        values_.pop_back();
+      }
+    }
+  }
+
+  // Merges count sorted, new entries into the arrays from the back: each
+  // entry is moved once, and a batch past every present key is a plain
+  // append
+  void MergeBack(Staged *batch, size_type count) {
+    if (count == 0) return;
+    size_type old_size = size();
+    size_type new_size = old_size + count;
+    if (new_size > capacity()) {
+      reserve(std::max(new_size, 2 * capacity()));
+    }
+    for (size_type i = 0; i < count; ++i) {
+      keys_.push_back(Key());
+      if constexpr (!std::is_void_v<T>) values_.push_back(Mapped());
+    }
+    size_type present = old_size;
+    for (size_type out = new_size; count > 0;) {
+      Staged &staged = batch[count - 1];
+      --out;
+      if (present > 0 && compare_(KeyOf(staged), keys_[present - 1])) {
+        --present;
+        keys_[out] = std::move(keys_[present]);
+        if constexpr (!std::is_void_v<T>) {
+          values_[out] = std::move(values_[present]);
+        }
+      } else {
+        --count;
+        if constexpr (std::is_void_v<T>) {
+          keys_[out] = std::move(staged);
+        } else {
+          keys_[out] = std::move(staged.first);
+          values_[out] = std::move(staged.second);
+        }
+      }
+    }
+  }
+
+  vector<Key> keys_;
+  Values values_;
+  Compare compare_;
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_FLAT_CONTAINER_H
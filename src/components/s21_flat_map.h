@@ -0,0 +1,82 @@
+#ifndef COMPONENTS_S21_FLAT_MAP_H
+#define COMPONENTS_S21_FLAT_MAP_H
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_flat_container.h"
+
+namespace s21 {
+/**
+ * Map kept as a sorted s21::vector of keys and a parallel one of mapped
+ * values (see FlatSortedContainer). Iterators behave like s21::map ones:
+ * *it is the key and it->value_ the mapped value.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class flat_map : public FlatSortedContainer<Key, Value, Compare> {
+ private:
+  using Base = FlatSortedContainer<Key, Value, Compare>;
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using const_iterator = typename Base::const_iterator;
+
+ public:
+  flat_map() = default;
+  explicit flat_map(const Compare &compare) : Base(compare) {}
+  flat_map(std::initializer_list<value_type> const &key_value_pairs)
+      : flat_map(key_value_pairs.begin(), key_value_pairs.end()) {}
+  template <typename InputIt>
+  flat_map(InputIt first, InputIt last, const Compare &compare = Compare())
+      : Base(compare) {
+    insert(first, last);
+  }
+
+  mapped_type &at(const key_type &key) {
+    const_iterator it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("flat_map::at: key not found");
+    }
+    return const_cast<mapped_type &>(it->value_);
+  }
+
+  // Inserts a value-initialized mapped value if key is missing
+  mapped_type &operator[](const key_type &key) {
+    return const_cast<mapped_type &>(this->Emplace(key).first->value_);
+  }
+
+  std::pair<const_iterator, bool> insert(const value_type &kvp) {
+    return this->Emplace(kvp.first, kvp.second);
+  }
+  std::pair<const_iterator, bool> insert(const key_type &key,
+                                         const mapped_type &value) {
+    return this->Emplace(key, value);
+  }
+
+  // Sorts the batch of key-value pairs and merges it in with one pass
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    this->InsertRange(first, last);
+  }
+
+  template <typename... Args>
+  std::pair<const_iterator, bool> try_emplace(const key_type &key,
+                                              Args &&...args) {
+    return this->Emplace(key, std::forward<Args>(args)...);
+  }
+
+  template <typename M>
+  std::pair<const_iterator, bool> insert_or_assign(const key_type &key,
+                                                   M &&value) {
+    auto result = this->Emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      const_cast<mapped_type &>(result.first->value_) = std::forward<M>(value);
+    }
+    return result;
+  }
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_FLAT_MAP_H
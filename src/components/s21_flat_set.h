@@ -0,0 +1,47 @@
+#ifndef COMPONENTS_S21_FLAT_SET_H
+#define COMPONENTS_S21_FLAT_SET_H
+
+#include <functional>
+#include <initializer_list>
+
+#include "s21_flat_container.h"
+
+namespace s21 {
+/**
+ * Set kept as a sorted s21::vector (see FlatSortedContainer). Meant for
+ * read-mostly tables: load them with insert(first, last), then look up and
+ * scan.
+ */
+template <typename Key, typename Compare = std::less<Key>>
+class flat_set : public FlatSortedContainer<Key, void, Compare> {
+ private:
+  using Base = FlatSortedContainer<Key, void, Compare>;
+  using key_type = Key;
+  using value_type = Key;
+  using const_iterator = typename Base::const_iterator;
+
+ public:
+  flat_set() = default;
+  explicit flat_set(const Compare &compare) : Base(compare) {}
+  flat_set(std::initializer_list<value_type> const &items)
+      : flat_set(items.begin(), items.end()) {}
+  template <typename InputIt>
+  flat_set(InputIt first, InputIt last, const Compare &compare = Compare())
+      : Base(compare) {
+    insert(first, last);
+  }
+
+  std::pair<const_iterator, bool> insert(const value_type &value) {
+    return this->Emplace(value);
+  }
+
+  // Sorts the batch and merges it in with one pass
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    this->InsertRange(first, last);
+  }
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_FLAT_SET_H
@@ -0,0 +1,518 @@
+#ifndef COMPONENTS_S21_HASH_TABLE_H
+#define COMPONENTS_S21_HASH_TABLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+
+namespace hash_detail {
+
+// Slot contents, laid out like the tree nodes: *it is key_, and maps add
+// value_
+template <typename Key, typename T>
+struct Entry {
+  template <typename... Args>
+  explicit Entry(const Key &key, Args &&...args)
+      : key_(key), value_(std::forward<Args>(args)...) {}
+  Key key_;
+  T value_;
+};
+
+template <typename Key>
+struct Entry<Key, void> {
+  explicit Entry(const Key &key) : key_(key) {}
+  Key key_;
+};
+
+// Control byte of a slot: kEmpty, kDeleted (a tombstone that keeps probe
+// sequences through it intact), or the top 7 bits of a full slot's hash
+constexpr signed char kEmpty = -128;
+constexpr signed char kDeleted = -2;
+
+constexpr std::size_t kGroupWidth = 16;
+
+// The control bytes of kGroupWidth consecutive slots, matched all at once.
+// Each function returns one bit per slot.
+class Group {
+ public:
+#if defined(__SSE2__)
+  explicit Group(const signed char *ctrl)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+
+  unsigned Match(signed char h2) const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+  }
+  // kEmpty and kDeleted are the control bytes with the sign bit set
+  unsigned MatchEmptyOrDeleted() const { return _mm_movemask_epi8(ctrl_); }
+
+ private:
+  __m128i ctrl_;
+#else
+  explicit Group(const signed char *ctrl) : ctrl_(ctrl) {}
+
+  unsigned Match(signed char h2) const {
+    unsigned bits = 0;
+    for (std::size_t i = 0; i < kGroupWidth; ++i) {
+      bits |= unsigned{ctrl_[i] == h2} << i;
+    }
+    return bits;
+  }
+  unsigned MatchEmptyOrDeleted() const {
+    unsigned bits = 0;
+    for (std::size_t i = 0; i < kGroupWidth; ++i) {
+      bits |= unsigned{ctrl_[i] < 0} << i;
+    }
+    return bits;
+  }
+
+ private:
+  const signed char *ctrl_;
+#endif
+
+ public:
+  unsigned MatchEmpty() const { return Match(kEmpty); }
+};
+
+// Hash and KeyEqual both opt in to lookups by other types than Key
+template <typename Hash, typename KeyEqual, typename = void>
+struct IsTransparent : std::false_type {};
+template <typename Hash, typename KeyEqual>
+struct IsTransparent<Hash, KeyEqual,
+                     std::void_t<typename Hash::is_transparent,
+                                 typename KeyEqual::is_transparent>>
+    : std::true_type {};
+
+}  // namespace hash_detail
+
+/**
+ * Shared part of unordered_set and unordered_map: an open addressing hash
+ * table in the style of a Swiss table. Entries sit in one flat slot array,
+ * and a parallel array of one control byte per slot holds 7 bits of each
+ * entry's hash. A lookup compares a whole group of 16 control bytes with
+ * one SSE2 instruction and only calls KeyEqual on the slots whose bits
+ * match, so a miss rarely touches an entry at all.
+ *
+ * Hashes are mixed before use, so identity hashes such as std::hash<int>
+ * still spread over the groups.
+ *
+ * Growth is incremental. Going past max_load_factor() allocates a table of
+ * twice the size, and from then on each insert moves the next
+ * kMigrateSlots slots of the old table over, so no single insert pays for
+ * the whole rehash. Until the old table is drained, lookups and erases
+ * look in both tables. reserve() migrates at once.
+ *
+ * Inserting may move entries between the two tables and so invalidates
+ * iterators; erasing invalidates only iterators to the erased entry.
+ */
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+class HashTable {
+ public:
+  using size_type = std::size_t;
+  using Entry = hash_detail::Entry<Key, T>;
+
+ private:
+  // Slots moved from the old table per insert while growing
+  static constexpr size_type kMigrateSlots = 64;
+  static constexpr float kDefaultMaxLoad = 0.875f;
+
+  struct Table {
+    signed char *ctrl_ = nullptr;
+    Entry *slots_ = nullptr;  // only the full slots hold an Entry
+    size_type capacity_ = 0;  // zero or a power of two >= kGroupWidth
+    size_type size_ = 0;
+    size_type deleted_ = 0;
+  };
+
+  template <typename K>
+  using EnableIfTransparent =
+      std::enable_if_t<hash_detail::IsTransparent<Hash, KeyEqual>::value &&
+                           !std::is_same_v<K, Key>,
+                       int>;
+
+ public:
+  class const_iterator {
+   private:
+    const HashTable *owner_ = nullptr;
+    const Table *table_ = nullptr;
+    size_type index_ = 0;
+    friend class HashTable;
+
+    const_iterator(const HashTable *owner, const Table *table,
+                   size_type index)
+        : owner_(owner), table_(table), index_(index) {}
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Entry *;
+    using reference = const Key &;
+
+    const_iterator() = default;
+
+    const Key &operator*() const { return table_->slots_[index_].key_; }
+    const Entry *operator->() const { return table_->slots_ + index_; }
+
+    const_iterator &operator++() {
+      ++index_;
+      owner_->SkipToFull(table_, index_);
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return table_ == other.table_ && index_ == other.index_;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+  };  // end class const_iterator
+
+  HashTable() = default;
+  explicit HashTable(size_type capacity, const Hash &hash = Hash(),
+                     const KeyEqual &equal = KeyEqual())
+      : hash_(hash), equal_(equal) {
+    reserve(capacity);
+  }
+  HashTable(const HashTable &other)
+      : max_load_factor_(other.max_load_factor_),
+        hash_(other.hash_),
+        equal_(other.equal_) {
+    reserve(other.size());
+    try {
+      for (const_iterator it = other.begin(); it != other.end(); ++it) {
+        Place(table_, Mix(hash_(it->key_)), *it.operator->());
+      }
+    } catch (...) {
+      Free(table_);
+      throw;
+    }
+  }
+  HashTable(HashTable &&other) noexcept { swap(other); }
+  ~HashTable() {
+    Free(old_);
+    Free(table_);
+  }
+
+  HashTable &operator=(const HashTable &other) {
+    if (this != &other) {
+      HashTable copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  HashTable &operator=(HashTable &&other) noexcept {
+    if (this != &other) {
+      HashTable moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  const_iterator begin() const {
+    const Table *table = &old_;
+    size_type index = cursor_;
+    SkipToFull(table, index);
+    return const_iterator(this, table, index);
+  }
+  const_iterator end() const {
+    return const_iterator(this, &table_, table_.capacity_);
+  }
+
+  size_type size() const { return table_.size_ + old_.size_; }
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    Free(old_);
+    cursor_ = 0;
+    DestroyEntries(table_);
+    std::fill(table_.ctrl_, table_.ctrl_ + table_.capacity_,
+              hash_detail::kEmpty);
+    table_.size_ = 0;
+    table_.deleted_ = 0;
+  }
+
+  void swap(HashTable &other) noexcept {
+    std::swap(table_, other.table_);
+    std::swap(old_, other.old_);
+    std::swap(cursor_, other.cursor_);
+    std::swap(max_load_factor_, other.max_load_factor_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+  }
+
+  size_type bucket_count() const { return table_.capacity_; }
+  float load_factor() const {
+    return table_.capacity_ == 0
+               ? 0.0f
+               : static_cast<float>(size()) / table_.capacity_;
+  }
+  float max_load_factor() const { return max_load_factor_; }
+  // Clamped to [0.25, 0.9375]: every probe sequence must reach an empty
+  // slot, and the table must not mostly hold empty groups
+  void max_load_factor(float load) {
+    max_load_factor_ = std::clamp(load, 0.25f, 0.9375f);
+  }
+
+  // Room for count entries without growing. Finishes a pending migration
+  // and rehashes at once if needed, so it is the one call that may stall.
+  void reserve(size_type count) {
+    FinishMigration();
+    if (count <= Threshold(table_.capacity_)) return;
+    StartMigration(CapacityFor(count));
+    FinishMigration();
+  }
+
+  Hash hash_function() const { return hash_; }
+  KeyEqual key_eq() const { return equal_; }
+
+  const_iterator find(const Key &key) const { return FindAny(key); }
+  bool contains(const Key &key) const { return FindAny(key) != end(); }
+  size_type count(const Key &key) const { return contains(key); }
+
+  // Lookups by any type that Hash and KeyEqual accept, without building a
+  // Key, when both declare is_transparent
+  template <typename K, EnableIfTransparent<K> = 0>
+  const_iterator find(const K &key) const {
+    return FindAny(key);
+  }
+  template <typename K, EnableIfTransparent<K> = 0>
+  bool contains(const K &key) const {
+    return FindAny(key) != end();
+  }
+  template <typename K, EnableIfTransparent<K> = 0>
+  size_type count(const K &key) const {
+    return contains(key);
+  }
+
+  // Returns the entry that followed pos
+  const_iterator erase(const_iterator pos) {
+    const_iterator next = std::next(pos);
+    EraseAt(const_cast<Table &>(*pos.table_), pos.index_);
+    return next;
+  }
+
+  size_type erase(const Key &key) {
+    const_iterator it = FindAny(key);
+    if (it == end()) return 0;
+    EraseAt(const_cast<Table &>(*it.table_), it.index_);
+    return 1;
+  }
+
+ protected:
+  // Builds the entry from key and args unless key is already present
+  template <typename... Args>
+  std::pair<const_iterator, bool> Emplace(const Key &key, Args &&...args) {
+    size_type hash = Mix(hash_(key));
+    const_iterator found = FindAny(key, hash);
+    if (found != end()) return {found, false};
+    if (old_.capacity_ != 0) MigrateStep();
+    // Entries still in the old table count too: they are bound for
+    // table_, and FinishMigration() must find room for them
+    if (size() + table_.deleted_ + 1 > Threshold(table_.capacity_)) {
+      FinishMigration();
+      // A table that is mostly tombstones is rebuilt at its size rather
+      // than doubled
+      size_type capacity = table_.capacity_;
+      if (size() + 1 > Threshold(capacity) / 2) capacity *= 2;
+      StartMigration(std::max(capacity, CapacityFor(size() + 1)));
+    }
+    size_type index = Place(table_, hash, key, std::forward<Args>(args)...);
+    return {const_iterator(this, &table_, index), true};
+  }
+
+ private:
+  // Spreads std::hash<int> style identity hashes: the low bits pick the
+  // group, the high 7 bits go to the control byte
+  static size_type Mix(size_type hash) {
+    std::uint64_t mixed = static_cast<std::uint64_t>(hash) *
+                          std::uint64_t{0x9E3779B97F4A7C15};
+    return static_cast<size_type>(mixed ^ (mixed >> 32));
+  }
+  static signed char H2(size_type hash) {
+    return static_cast<signed char>(hash >> (sizeof(size_type) * 8 - 7));
+  }
+
+  size_type Threshold(size_type capacity) const {
+    return static_cast<size_type>(capacity * max_load_factor_);
+  }
+
+  size_type CapacityFor(size_type count) const {
+    size_type capacity = hash_detail::kGroupWidth;
+    while (Threshold(capacity) < count) capacity *= 2;
+    return capacity;
+  }
+
+  // Visits the groups of table in triangular order, which reaches every
+  // group of a power-of-two table, until visit returns true
+  template <typename Visit>
+  static void Probe(const Table &table, size_type hash, Visit visit) {
+    size_type mask = table.capacity_ / hash_detail::kGroupWidth - 1;
+    size_type group = hash & mask;
+    for (size_type step = 1;; ++step) {
+      const signed char *ctrl =
+          table.ctrl_ + group * hash_detail::kGroupWidth;
+      if (visit(hash_detail::Group(ctrl), group * hash_detail::kGroupWidth)) {
+        return;
+      }
+      group = (group + step) & mask;
+    }
+  }
+
+  // Slot index of key in table, or table.capacity_
+  template <typename K>
+  size_type FindIn(const Table &table, const K &key, size_type hash) const {
+    if (table.size_ == 0) return table.capacity_;
+    size_type found = table.capacity_;
+    signed char h2 = H2(hash);
+    Probe(table, hash, [&](const hash_detail::Group &group, size_type first) {
+      for (unsigned bits = group.Match(h2); bits != 0; bits &= bits - 1) {
+        size_type index = first + __builtin_ctz(bits);
+        if (equal_(table.slots_[index].key_, key)) {
+          found = index;
+          return true;
+        }
+      }
+      return group.MatchEmpty() != 0;
+    });
+    return found;
+  }
+
+  template <typename K>
+  const_iterator FindAny(const K &key) const {
+    return FindAny(key, Mix(hash_(key)));
+  }
+
+  template <typename K>
+  const_iterator FindAny(const K &key, size_type hash) const {
+    size_type index = FindIn(table_, key, hash);
+    if (index != table_.capacity_) {
+      return const_iterator(this, &table_, index);
+    }
+    index = FindIn(old_, key, hash);
+    if (index != old_.capacity_) return const_iterator(this, &old_, index);
+    return end();
+  }
+
+  // Builds an entry in the first free slot of key's probe sequence; the
+  // caller has made sure the key is absent and the table has room
+  template <typename... Args>
+  size_type Place(Table &table, size_type hash, Args &&...args) {
+    size_type index = 0;
+    Probe(table, hash, [&index](const hash_detail::Group &group,
+                                size_type first) {
+      unsigned bits = group.MatchEmptyOrDeleted();
+      if (bits == 0) return false;
+      index = first + __builtin_ctz(bits);
+      return true;
+    });
+    new (table.slots_ + index) Entry(std::forward<Args>(args)...);
+    if (table.ctrl_[index] == hash_detail::kDeleted) --table.deleted_;
+    table.ctrl_[index] = H2(hash);
+    ++table.size_;
+    return index;
+  }
+
+  void EraseAt(Table &table, size_type index) {
+    table.slots_[index].~Entry();
+    table.ctrl_[index] = hash_detail::kDeleted;
+    --table.size_;
+    ++table.deleted_;
+  }
+
+  // Moves index up to the next full slot, carrying on from the end of the
+  // old table into the current one
+  void SkipToFull(const Table *&table, size_type &index) const {
+    for (;;) {
+      while (index < table->capacity_ && table->ctrl_[index] < 0) ++index;
+      if (index < table->capacity_ || table == &table_) return;
+      table = &table_;
+      index = 0;
+    }
+  }
+
+  void StartMigration(size_type capacity) {
+    Table fresh = Allocate(capacity);
+    old_ = table_;
+    table_ = fresh;
+    cursor_ = 0;
+  }
+
+  // Moves the next kMigrateSlots slots of the old table over. They are
+  // left as tombstones, so the old table's probe sequences stay intact.
+  void MigrateStep() {
+    size_type stop = std::min(cursor_ + kMigrateSlots, old_.capacity_);
+    for (; cursor_ < stop; ++cursor_) {
+      if (old_.ctrl_[cursor_] < 0) continue;
+      Entry &entry = old_.slots_[cursor_];
+      Place(table_, Mix(hash_(entry.key_)), std::move(entry));
+      EraseAt(old_, cursor_);
+    }
+    if (cursor_ == old_.capacity_) {
+      Free(old_);
+      cursor_ = 0;
+    }
+  }
+
+  void FinishMigration() {
+    while (old_.capacity_ != 0) MigrateStep();
+  }
+
+  static Table Allocate(size_type capacity) {
+    Table table;
+    table.slots_ = std::allocator<Entry>().allocate(capacity);
+    try {
+      table.ctrl_ = new signed char[capacity];
+    } catch (...) {
+      std::allocator<Entry>().deallocate(table.slots_, capacity);
+      throw;
+    }
+    std::fill(table.ctrl_, table.ctrl_ + capacity, hash_detail::kEmpty);
+    table.capacity_ = capacity;
+    return table;
+  }
+
+  static void DestroyEntries(Table &table) {
+    if constexpr (!std::is_trivially_destructible_v<Entry>) {
+      for (size_type i = 0; i < table.capacity_; ++i) {
+        if (table.ctrl_[i] >= 0) table.slots_[i].~Entry();
+      }
+    }
+  }
+
+  static void Free(Table &table) {
+    if (table.capacity_ == 0) return;
+    DestroyEntries(table);
+    delete[] table.ctrl_;
+    std::allocator<Entry>().deallocate(table.slots_, table.capacity_);
+    table = Table();
+  }
+
+  Table table_;
+  // The table being drained into table_ while growing, else empty. Its
+  // slots below cursor_ have been moved.
+  Table old_;
+  size_type cursor_ = 0;
+  float max_load_factor_ = kDefaultMaxLoad;
+  Hash hash_;
+  KeyEqual equal_;
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_HASH_TABLE_H
@@ -1,80 +1,95 @@
 #ifndef SRC_COMPONENTS_S21_SET_H
 #define SRC_COMPONENTS_S21_SET_H
 
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
 #include "s21_sorted_container.h"
 
 namespace s21 {
-template <typename Key, typename Value>
-class map : public BinaryTree<Key, Value> {
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          template <typename> class Storage = HeapStorage,
+          typename Balance = RedBlackBalance>
+class map : public BinaryTree<Key, Value, Compare, Storage, Balance> {
  private:
   using key_type = Key;
   using mapped_type = Value;
+  using Tree =
+      BinaryTree<key_type, mapped_type, Compare, Storage, Balance>;
   using value_type = std::pair<const key_type, mapped_type>;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using const_iterator =
-      typename BinaryTree<key_type, value_type>::const_iterator;
+  using const_iterator = typename Tree::const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
   using size_type = size_t;
+  using node_type = typename Tree::NodeHandle;
+  using insert_return_type = typename Tree::InsertReturn;
+  using range_view = typename Tree::RangeView;
+  using finger_type = typename Tree::Finger;
+
+ protected:
+  using Node = typename Tree::Node;
 
  public:
-  map() : BinaryTree<key_type, mapped_type>(){};
-  map(std::initializer_list<value_type> const &key_value_pairs) {
-    for (const auto &kvp : key_value_pairs) this->insert(kvp);
+  map() : Tree(){};
+  map(std::initializer_list<value_type> const &key_value_pairs)
+      : map(key_value_pairs.begin(), key_value_pairs.end()) {}
+  explicit map(const Compare &compare) : Tree(compare) {}
+  template <typename InputIt>
+  map(InputIt first, InputIt last, const Compare &compare = Compare())
+      : Tree(compare) {
+    assign(first, last);
   }
-  map(const map &s) : BinaryTree<key_type, mapped_type>() {
-    this->DestroyTree(this->root_);
-    this->root_ = this->CopyTree(s.root_, nullptr);
+  map(const map &s) : Tree() {
+    this->CopyFrom(s);
   };
-  map(map &&s) noexcept : BinaryTree<key_type, mapped_type>() {
-    this->root_ = s.root_;
-    s.root_ = nullptr;
-  }
-  ~map() {
-    this->DestroyTree(this->root_);
-    this->root_ = nullptr;
+  map(map &&s) noexcept : Tree() {
+    this->MoveFrom(s);
   }
+  ~map() { this->Clear(); }
   map &operator=(const map &s) {
     if (this != &s) {
-      this->DestroyTree(this->root_);
-      this->root_ = this->CopyTree(s.root_, nullptr);
+      this->CopyFrom(s);
     }
     return *this;
   }
 
   map &operator=(map &&s) noexcept {
     if (this != &s) {
-      this->DestroyTree(this->root_);
-      this->root_ = s.root_;
-      s.root_ = nullptr;
+      this->MoveFrom(s);
     }
     return *this;
   }
 
-  mapped_type &at(const key_type &key) { return this->FindNode(key)->value_; }
+  mapped_type &at(const key_type &key) {
+    const_iterator it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("map::at: key not found");
+    }
+    return const_cast<mapped_type &>(it->value_);
+  }
 
+  // Inserts a value-initialized mapped value if key is missing
   mapped_type &operator[](const key_type &key) {
-    return this->FindNode(key)->value_;
+    return const_cast<mapped_type &>(this->TryEmplace(key).first->value_);
   }
 
-  const_iterator begin() const {
-    return BinaryTree<key_type, mapped_type>::Begin();
+  const_iterator begin() const { return Tree::Begin(); }
+  const_iterator end() const { return Tree::End(); }
+  // begin(), rbegin() and --end() are O(1): the tree caches both ends
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
   }
-  const_iterator end() const {
-    return BinaryTree<key_type, mapped_type>::End();
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
   }
 
-  size_type size() {
-    this->counter_ = 0;
-    this->CountNodes(this->root_);
-    return this->counter_;
-  }
+  size_type size() const { return this->Size(); }
 
   bool empty() { return this->TreeEmpty(); }
 
-  void clear() {
-    this->DestroyTree(this->root_);
-    this->root_ = nullptr;
-  }
+  void clear() { this->Clear(); }
 
   std::pair<const_iterator, bool> insert(const value_type &kvp) {
     return this->AddNode(kvp.first, kvp.second);
@@ -83,20 +98,288 @@ class map : public BinaryTree<Key, Value> {
                                          const mapped_type &value) {
     return this->AddNode(key, value);
   }
+  insert_return_type insert(node_type &&node) {
+    return this->AddNode(std::move(node));
+  }
+
+  // Replaces the contents with [first, last); O(n) for sorted input
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    this->InsertBatch(
+        this->MakeBatch(first, last, [this](const value_type &kvp) {
+          return this->CreateNode(kvp.first, kvp.second);
+        }));
+  }
+
+  template <typename... Args>
+  std::vector<std::pair<const_iterator, bool>> insert_many(Args &&...args) {
+    std::vector<Node *> batch = this->MakePackBatch(
+        [this](const auto &kvp) {
+          return this->CreateNode(kvp.first, kvp.second);
+        },
+        args...);
+    std::vector<std::pair<const_iterator, bool>> result;
+    this->InsertBatch(batch, &result);
+    return result;
+  }
+
+  // Upserts find or create the slot in a single descent. The mapped value
+  // is constructed in place from args and only if key is missing.
+  template <typename... Args>
+  std::pair<const_iterator, bool> try_emplace(const key_type &key,
+                                              Args &&...args) {
+    return this->TryEmplace(key, std::forward<Args>(args)...);
+  }
+  // O(1) amortized search when key belongs right before hint
+  template <typename... Args>
+  const_iterator try_emplace(const_iterator hint, const key_type &key,
+                             Args &&...args) {
+    return this->TryEmplaceHint(hint, key, std::forward<Args>(args)...).first;
+  }
+  // In place like try_emplace when args are a key and a mapped value, a
+  // pair, or piecewise_construct with a key tuple and a mapped tuple: the
+  // mapped value is only built if the key is missing. Any other args build
+  // a whole value_type first, so prefer try_emplace.
+  template <typename... Args>
+  std::pair<const_iterator, bool> emplace(Args &&...args) {
+    return EmplaceWith(
+        [this](const key_type &key, auto &&...mapped_args) {
+          return this->TryEmplace(
+              key, std::forward<decltype(mapped_args)>(mapped_args)...);
+        },
+        std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  const_iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return EmplaceWith(
+               [this, hint](const key_type &key, auto &&...mapped_args) {
+                 return this->TryEmplaceHint(
+                     hint, key,
+                     std::forward<decltype(mapped_args)>(mapped_args)...);
+               },
+               std::forward<Args>(args)...)
+        .first;
+  }
+  template <typename M>
   std::pair<const_iterator, bool> insert_or_assign(const key_type &key,
-                                                   const mapped_type &value) {
-    if (this->contains(key)) {
-      this->at(key) = value;
-      return {this->find(key), false};
+                                                   M &&value) {
+    auto result = this->TryEmplace(key, std::forward<M>(value));
+    if (!result.second) {
+      const_cast<mapped_type &>(result.first->value_) = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  const_iterator erase(const_iterator pos) { return this->Erase(pos); }
+  // Removes [first, last) in O(k log n) for k removed keys
+  const_iterator erase(const_iterator first, const_iterator last) {
+    return this->EraseRange(first, last);
+  }
+  size_type erase(const key_type &key) {
+    const_iterator pos = find(key);
+    if (pos == end()) return 0;
+    erase(pos);
+    return 1;
+  }
+
+  template <typename K, typename V, typename C, template <typename> class S,
+            typename B, typename Pred>
+  friend size_t erase_if(map<K, V, C, S, B> &container, Pred pred);
+  node_type extract(const_iterator pos) { return this->Extract(pos); }
+  node_type extract(const key_type &key) { return this->Extract(find(key)); }
+
+  // Under SplayBalance a lookup moves the key found to the root, so a
+  // splay map is only searched through a non-const reference
+  const_iterator find(const key_type &key) const {
+    static_assert(!Balance::kSelfAdjusting,
+                  "a splay map restructures on find, use a non-const one");
+    return this->FindNode(this->root_, key);
+  }
+  const_iterator find(const key_type &key) {
+    return this->AccessNode(this->root_, key);
+  }
+
+  bool contains(const key_type &key) const {
+    static_assert(!Balance::kSelfAdjusting,
+                  "a splay map restructures on find, use a non-const one");
+    return this->Contains(this->root_, key);
+  }
+  bool contains(const key_type &key) {
+    return this->AccessNode(this->root_, key) != this->end();
+  }
+
+  // Looks up all keys of [first, last) at once, overlapping the cache
+  // misses of up to 16 descents; one result per key, in input order
+  template <typename ForwardIt>
+  std::vector<const_iterator> find_many(ForwardIt first,
+                                        ForwardIt last) const {
+    std::vector<const_iterator> result;
+    result.reserve(std::distance(first, last));
+    this->FindBatch(first, last, [this, &result](size_type, Node *node) {
+      result.push_back(this->MakeIterator(node));
+    });
+    return result;
+  }
+  template <typename ForwardIt>
+  std::vector<bool> contains_many(ForwardIt first, ForwardIt last) const {
+    std::vector<bool> result;
+    result.reserve(std::distance(first, last));
+    this->FindBatch(first, last, [&result](size_type, Node *node) {
+      result.push_back(node != nullptr);
+    });
+    return result;
+  }
+
+  // Bounds are found in one O(log n) descent, scanning the range then
+  // costs O(1) amortized per key
+  const_iterator lower_bound(const key_type &key) const {
+    return this->LowerBound(key);
+  }
+  const_iterator upper_bound(const key_type &key) const {
+    return this->UpperBound(key);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    return this->EqualRange(key);
+  }
+  // Keys in [low, high), for use in range-based for
+  range_view range(const key_type &low, const key_type &high) const {
+    return this->Range(low, high);
+  }
+
+  // Heterogeneous lookup, enabled when Compare is transparent (such as
+  // std::less<>): e.g. a string_view is compared with string keys directly
+  // instead of being copied into a temporary key first
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) const {
+    static_assert(!Balance::kSelfAdjusting,
+                  "a splay map restructures on find, use a non-const one");
+    return this->FindNode(this->root_, key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) {
+    return this->AccessNode(this->root_, key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    static_assert(!Balance::kSelfAdjusting,
+                  "a splay map restructures on find, use a non-const one");
+    return this->Contains(this->root_, key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) {
+    return this->AccessNode(this->root_, key) != this->end();
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator lower_bound(const K &key) const {
+    return this->LowerBound(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator upper_bound(const K &key) const {
+    return this->UpperBound(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+    return this->EqualRange(key);
+  }
+
+  Compare key_comp() const { return this->compare_; }
+
+  // A cursor whose lookups start from where the previous one ended
+  finger_type finger() const { return finger_type(*this); }
+
+  // Calls on_match(key, it) for every key of the sorted [first, last) that
+  // is present, walking both sequences in step through one finger
+  template <typename InputIt, typename OnMatch>
+  void merge_join(InputIt first, InputIt last, OnMatch on_match) const {
+    finger_type cursor = finger();
+    for (; first != last; ++first) {
+      const_iterator it = cursor.find(*first);
+      if (it != end()) on_match(*first, it);
     }
-    return this->insert(key, value);
   }
 
-  void erase(const_iterator pos) { this->Erase(pos); }
+  // Order statistics, O(log n) thanks to the per-node subtree counts
+  const_iterator nth(size_type k) const { return this->Select(k); }
+  size_type rank(const key_type &key) const { return this->Rank(key); }
+
+  void swap(map &other) { this->Swap(other); }
+
+  void merge(map &other) { this->Merge(other); }
+
+  // Leaves the keys less than key here and returns the rest. Nodes are
+  // relinked, not reallocated, in O(log n) (a pooled container recreates
+  // the moved nodes in the pool of the returned one).
+  map split(const key_type &key) {
+    map upper(this->compare_);
+    this->SplitInto(key, upper);
+    return upper;
+  }
+  // Appends other, whose keys must all be greater than ours, in O(log n)
+  // and leaves it empty; overlapping key ranges fall back to merge()
+  void join(map &other) { this->JoinFrom(other); }
+  void join(map &&other) { this->JoinFrom(other); }
+  // Moves [first, last) out into a new container with two splits and a join
+  map extract(const_iterator first, const_iterator last) {
+    map extracted(this->compare_);
+    this->ExtractRange(first, last, extracted);
+    return extracted;
+  }
 
-  bool contains(const key_type &key) { return this->FindNode(key); }
+ private:
+  template <typename P>
+  struct IsPair : std::false_type {};
+  template <typename K, typename V>
+  struct IsPair<std::pair<K, V>> : std::true_type {};
+
+  // Splits emplace's args into the key and the mapped value's args and
+  // hands them to place(key, mapped_args...)
+  template <typename Place, typename K, typename M>
+  static auto EmplaceWith(Place place, K &&key, M &&mapped) {
+    return place(std::forward<K>(key), std::forward<M>(mapped));
+  }
+  template <typename Place, typename P,
+            typename = std::enable_if_t<IsPair<std::decay_t<P>>::value>>
+  static auto EmplaceWith(Place place, P &&kvp) {
+    return place(std::get<0>(std::forward<P>(kvp)),
+                 std::get<1>(std::forward<P>(kvp)));
+  }
+  template <typename Place, typename... KeyArgs, typename... MappedArgs>
+  static auto EmplaceWith(Place place, std::piecewise_construct_t,
+                          std::tuple<KeyArgs...> key_args,
+                          std::tuple<MappedArgs...> mapped_args) {
+    key_type key = std::make_from_tuple<key_type>(std::move(key_args));
+    return std::apply(
+        [&place, &key](auto &&...args) {
+          return place(key, std::forward<decltype(args)>(args)...);
+        },
+        std::move(mapped_args));
+  }
+  template <typename Place, typename... Args>
+  static auto EmplaceWith(Place place, Args &&...args) {
+    value_type kvp(std::forward<Args>(args)...);
+    return place(kvp.first, std::move(kvp.second));
+  }
 };
 
+// Removes the entries for which pred(entry) holds (entry.key_ and
+// entry.value_) and returns how many. One O(n) pass frees them and
+// rebuilds the survivors into a balanced tree.
+template <typename Key, typename Value, typename Compare,
+          template <typename> class Storage, typename Balance, typename Pred>
+size_t erase_if(map<Key, Value, Compare, Storage, Balance> &container,
+                Pred pred) {
+  return container.EraseIf(pred);
+}
+
 }  // namespace s21
 
-#endif
\ No newline at end of file
+#endif  // SRC_COMPONENTS_S21_SET_H
\ No newline at end of file
@@ -0,0 +1,198 @@
+#ifndef COMPONENTS_S21_MULTIMAP_H
+#define COMPONENTS_S21_MULTIMAP_H
+
+#include "s21_sorted_container.h"
+
+namespace s21 {
+/**
+ * Sorted key-value container that keeps equal keys, on the same red-black
+ * tree and node layout as s21::map: one node per value, no per-key vector.
+ * Values with equal keys stay in insertion order.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          template <typename> class Storage = HeapStorage>
+class multimap : public BinaryTree<Key, Value, Compare, Storage> {
+ private:
+  using key_type = Key;
+  using mapped_type = Value;
+  using Tree = BinaryTree<key_type, mapped_type, Compare, Storage>;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using const_iterator = typename Tree::const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using size_type = size_t;
+  using node_type = typename Tree::NodeHandle;
+  using range_view = typename Tree::RangeView;
+
+ protected:
+  using Node = typename Tree::Node;
+
+ public:
+  multimap() : Tree(){};
+  multimap(std::initializer_list<value_type> const &key_value_pairs)
+      : multimap(key_value_pairs.begin(), key_value_pairs.end()) {}
+  explicit multimap(const Compare &compare) : Tree(compare) {}
+  template <typename InputIt>
+  multimap(InputIt first, InputIt last, const Compare &compare = Compare())
+      : Tree(compare) {
+    assign(first, last);
+  }
+  multimap(const multimap &mm) : Tree() { this->CopyFrom(mm); }
+  multimap(multimap &&mm) noexcept : Tree() { this->MoveFrom(mm); }
+  ~multimap() { this->Clear(); }
+  multimap &operator=(const multimap &mm) {
+    if (this != &mm) {
+      this->CopyFrom(mm);
+    }
+    return *this;
+  }
+
+  multimap &operator=(multimap &&mm) noexcept {
+    if (this != &mm) {
+      this->MoveFrom(mm);
+    }
+    return *this;
+  }
+
+  const_iterator begin() const { return Tree::Begin(); }
+  const_iterator end() const { return Tree::End(); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const { return this->Size(); }
+
+  bool empty() { return this->TreeEmpty(); }
+
+  void clear() { this->Clear(); }
+
+  // Always inserts; the new value goes after the ones with an equal key
+  const_iterator insert(const value_type &kvp) {
+    return this->AddMultiNode(kvp.first, kvp.second);
+  }
+  const_iterator insert(const key_type &key, const mapped_type &value) {
+    return this->AddMultiNode(key, value);
+  }
+  const_iterator insert(node_type &&node) {
+    return this->AddMultiNode(std::move(node));
+  }
+  template <typename... Args>
+  const_iterator emplace(Args &&...args) {
+    value_type kvp(std::forward<Args>(args)...);
+    return this->AddMultiNode(kvp.first, std::move(kvp.second));
+  }
+
+  node_type extract(const_iterator pos) { return this->Extract(pos); }
+  // Extracts the first of the values stored under key
+  node_type extract(const key_type &key) { return this->Extract(find(key)); }
+
+  // Replaces the contents with [first, last); O(n) for sorted input
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    this->InsertMultiBatch(
+        this->MakeBatch(first, last, [this](const value_type &kvp) {
+          return this->CreateNode(kvp.first, kvp.second);
+        }));
+  }
+
+  template <typename... Args>
+  std::vector<std::pair<const_iterator, bool>> insert_many(Args &&...args) {
+    std::vector<std::pair<const_iterator, bool>> result;
+    result.reserve(sizeof...(args));
+    (result.emplace_back(insert(args), true), ...);
+    return result;
+  }
+
+  const_iterator erase(const_iterator pos) { return this->Erase(pos); }
+  // Removes [first, last) in O(k log n) for k removed keys
+  const_iterator erase(const_iterator first, const_iterator last) {
+    return this->EraseRange(first, last);
+  }
+  // Removes every entry whose key is equal to key
+  size_type erase(const key_type &key) {
+    auto [first, last] = equal_range(key);
+    size_type count = this->CountEqual(key);
+    erase(first, last);
+    return count;
+  }
+
+  template <typename K, typename V, typename C, template <typename> class S,
+            typename Pred>
+  friend size_t erase_if(multimap<K, V, C, S> &container, Pred pred);
+
+  // First of the values stored under key
+  const_iterator find(const key_type &key) const {
+    return this->FindNode(this->root_, key);
+  }
+
+  bool contains(const key_type &key) const {
+    return this->Contains(this->root_, key);
+  }
+
+  size_type count(const key_type &key) const { return this->CountEqual(key); }
+
+  const_iterator lower_bound(const key_type &key) const {
+    return this->LowerBound(key);
+  }
+  const_iterator upper_bound(const key_type &key) const {
+    return this->UpperBound(key);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    return this->MultiEqualRange(key);
+  }
+  // Keys in [low, high), for use in range-based for
+  range_view range(const key_type &low, const key_type &high) const {
+    return this->Range(low, high);
+  }
+
+  // Heterogeneous lookup, enabled when Compare is transparent
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) const {
+    return this->FindNode(this->root_, key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return this->Contains(this->root_, key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) const {
+    return this->CountEqual(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+    return this->MultiEqualRange(key);
+  }
+
+  Compare key_comp() const { return this->compare_; }
+
+  // Order statistics, O(log n) thanks to the per-node subtree counts
+  const_iterator nth(size_type k) const { return this->Select(k); }
+  size_type rank(const key_type &key) const { return this->Rank(key); }
+
+  void swap(multimap &other) { this->Swap(other); }
+
+  // Takes every node of other; equal keys from other go after ours
+  void merge(multimap &other) { this->MergeAll(other); }
+};
+
+// Removes the entries for which pred(entry) holds, see erase_if for map
+template <typename Key, typename Value, typename Compare,
+          template <typename> class Storage, typename Pred>
+size_t erase_if(multimap<Key, Value, Compare, Storage> &container,
+                Pred pred) {
+  return container.EraseIf(pred);
+}
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_MULTIMAP_H
@@ -0,0 +1,188 @@
+#ifndef COMPONENTS_S21_MULTISET_H
+#define COMPONENTS_S21_MULTISET_H
+
+#include "s21_sorted_container.h"
+
+namespace s21 {
+/**
+ * Sorted set that keeps equal keys, on the same red-black tree and node
+ * layout as s21::set. Equal keys stay in insertion order. count() and
+ * equal_range() cost O(log n) and O(log n + k) thanks to the subtree counts.
+ */
+template <typename Key, typename Compare = std::less<Key>,
+          template <typename> class Storage = HeapStorage>
+class multiset : public BinaryTree<Key, void, Compare, Storage> {
+ private:
+  using key_type = Key;
+  using Tree = BinaryTree<key_type, void, Compare, Storage>;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using const_iterator = typename Tree::const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using size_type = size_t;
+  using node_type = typename Tree::NodeHandle;
+  using range_view = typename Tree::RangeView;
+
+ protected:
+  using Node = typename Tree::Node;
+
+ public:
+  multiset() : Tree(){};
+  multiset(std::initializer_list<value_type> const &items)
+      : multiset(items.begin(), items.end()) {}
+  explicit multiset(const Compare &compare) : Tree(compare) {}
+  template <typename InputIt>
+  multiset(InputIt first, InputIt last, const Compare &compare = Compare())
+      : Tree(compare) {
+    assign(first, last);
+  }
+  multiset(const multiset &ms) : Tree() { this->CopyFrom(ms); }
+  multiset(multiset &&ms) noexcept : Tree() { this->MoveFrom(ms); }
+  ~multiset() { this->Clear(); }
+  multiset &operator=(const multiset &ms) {
+    if (this != &ms) {
+      this->CopyFrom(ms);
+    }
+    return *this;
+  }
+
+  multiset &operator=(multiset &&ms) noexcept {
+    if (this != &ms) {
+      this->MoveFrom(ms);
+    }
+    return *this;
+  }
+
+  const_iterator begin() const { return Tree::Begin(); }
+  const_iterator end() const { return Tree::End(); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const { return this->Size(); }
+
+  bool empty() { return this->TreeEmpty(); }
+
+  void clear() { this->Clear(); }
+
+  // Always inserts; the new key goes after the ones equal to it
+  const_iterator insert(const value_type &value) {
+    return this->AddMultiNode(value);
+  }
+  const_iterator insert(node_type &&node) {
+    return this->AddMultiNode(std::move(node));
+  }
+
+  node_type extract(const_iterator pos) { return this->Extract(pos); }
+  // Extracts the first of the keys equal to key
+  node_type extract(const key_type &key) { return this->Extract(find(key)); }
+
+  // Replaces the contents with [first, last); O(n) for sorted input
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    this->InsertMultiBatch(
+        this->MakeBatch(first, last, [this](const value_type &key) {
+          return this->CreateNode(key);
+        }));
+  }
+
+  template <typename... Args>
+  std::vector<std::pair<const_iterator, bool>> insert_many(Args &&...args) {
+    std::vector<std::pair<const_iterator, bool>> result;
+    result.reserve(sizeof...(args));
+    (result.emplace_back(insert(args), true), ...);
+    return result;
+  }
+
+  const_iterator erase(const_iterator pos) { return this->Erase(pos); }
+  // Removes [first, last) in O(k log n) for k removed keys
+  const_iterator erase(const_iterator first, const_iterator last) {
+    return this->EraseRange(first, last);
+  }
+  // Removes every key equal to key
+  size_type erase(const key_type &key) {
+    auto [first, last] = equal_range(key);
+    size_type count = this->CountEqual(key);
+    erase(first, last);
+    return count;
+  }
+
+  template <typename K, typename C, template <typename> class S,
+            typename Pred>
+  friend size_t erase_if(multiset<K, C, S> &container, Pred pred);
+
+  // First of the keys equal to key
+  const_iterator find(const key_type &key) const {
+    return this->FindNode(this->root_, key);
+  }
+
+  bool contains(const key_type &key) const {
+    return this->Contains(this->root_, key);
+  }
+
+  size_type count(const key_type &key) const { return this->CountEqual(key); }
+
+  const_iterator lower_bound(const key_type &key) const {
+    return this->LowerBound(key);
+  }
+  const_iterator upper_bound(const key_type &key) const {
+    return this->UpperBound(key);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    return this->MultiEqualRange(key);
+  }
+  // Keys in [low, high), for use in range-based for
+  range_view range(const key_type &low, const key_type &high) const {
+    return this->Range(low, high);
+  }
+
+  // Heterogeneous lookup, enabled when Compare is transparent
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) const {
+    return this->FindNode(this->root_, key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return this->Contains(this->root_, key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) const {
+    return this->CountEqual(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+    return this->MultiEqualRange(key);
+  }
+
+  Compare key_comp() const { return this->compare_; }
+
+  // Order statistics, O(log n) thanks to the per-node subtree counts
+  const_iterator nth(size_type k) const { return this->Select(k); }
+  size_type rank(const key_type &key) const { return this->Rank(key); }
+
+  void swap(multiset &other) { this->Swap(other); }
+
+  // Takes every node of other; equal keys from other go after ours
+  void merge(multiset &other) { this->MergeAll(other); }
+};
+
+// Removes the keys for which pred(entry) holds, see erase_if for set
+template <typename Key, typename Compare, template <typename> class Storage,
+          typename Pred>
+size_t erase_if(multiset<Key, Compare, Storage> &container, Pred pred) {
+  return container.EraseIf(pred);
+}
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_MULTISET_H
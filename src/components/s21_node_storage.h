@@ -0,0 +1,114 @@
+#ifndef S21_CONTAINERS_H_S21_NODE_STORAGE_H
+#define S21_CONTAINERS_H_S21_NODE_STORAGE_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @file s21_node_storage.h
+ * @brief Node storage policies for the tree based containers
+ * @details BinaryTree never calls new/delete on its nodes itself, it asks the
+ * storage policy it was instantiated with:
+ *
+ * - HeapStorage allocates every node on its own. Nodes can move freely
+ * between trees (node handles, merge) because nobody owns the memory but the
+ * node itself.
+ *
+ * - PoolStorage carves nodes out of large contiguous chunks owned by one
+ * tree and recycles erased nodes through an intrusive free list. There is no
+ * per-node malloc header, neighbouring keys tend to share cache lines and
+ * clear() hands whole chunks back at once. Nodes moved to a tree with another
+ * pool are recreated there.
+ *
+ * Both policies expose the same interface: Create(args...), Destroy(node),
+ * Release() and swap(), plus two traits used by the tree.
+ */
+
+namespace s21 {
+
+template <typename Node>
+class HeapStorage {
+ public:
+  // A node created here may be destroyed through any other HeapStorage
+  static constexpr bool kSharesNodes = true;
+  // Release() does not free anything, every node has to be destroyed
+  static constexpr bool kBulkRelease = false;
+
+  template <typename... Args>
+  static Node *Create(Args &&...args) {
+    return new Node(std::forward<Args>(args)...);
+  }
+  static void Destroy(Node *node) { delete node; }
+  void Release() noexcept {}
+  void swap(HeapStorage &) noexcept {}
+};
+
+template <typename Node>
+class PoolStorage {
+ public:
+  static constexpr bool kSharesNodes = false;
+  static constexpr bool kBulkRelease = true;
+
+  PoolStorage() = default;
+  PoolStorage(const PoolStorage &) = delete;
+  PoolStorage &operator=(const PoolStorage &) = delete;
+  ~PoolStorage() { Release(); }
+
+  template <typename... Args>
+  Node *Create(Args &&...args) {
+    Slot *slot = free_;
+    if (slot != nullptr) {
+      free_ = slot->next;
+    } else {
+      if (used_ == kChunkNodes) {
+        chunks_.push_back(new Slot[kChunkNodes]);
+        used_ = 0;
+      }
+      slot = chunks_.back() + used_++;
+    }
+    return new (slot->bytes) Node(std::forward<Args>(args)...);
+  }
+
+  // Runs the destructor and puts the slot on the free list
+  void Destroy(Node *node) {
+    node->~Node();
+    Slot *slot = reinterpret_cast<Slot *>(node);
+    slot->next = free_;
+    free_ = slot;
+  }
+
+  // Frees every chunk. Nodes still alive are dropped without destruction,
+  // so the caller destroys them first unless Node is trivially destructible
+  void Release() noexcept {
+    for (Slot *chunk : chunks_) delete[] chunk;
+    chunks_.clear();
+    free_ = nullptr;
+    used_ = kChunkNodes;
+  }
+
+  void swap(PoolStorage &other) noexcept {
+    chunks_.swap(other.chunks_);
+    std::swap(free_, other.free_);
+    std::swap(used_, other.used_);
+  }
+
+ private:
+  union Slot {
+    Slot *next;
+    alignas(Node) unsigned char bytes[sizeof(Node)];
+  };
+
+  static constexpr std::size_t kChunkBytes = 64 * 1024;
+  static constexpr std::size_t kChunkNodes =
+      kChunkBytes / sizeof(Slot) > 0 ? kChunkBytes / sizeof(Slot) : 1;
+
+  std::vector<Slot *> chunks_;
+  Slot *free_ = nullptr;
+  std::size_t used_ = kChunkNodes;  // slots handed out from the last chunk
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_H_S21_NODE_STORAGE_H
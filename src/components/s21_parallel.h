@@ -0,0 +1,141 @@
+#ifndef COMPONENTS_S21_PARALLEL_H
+#define COMPONENTS_S21_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @file s21_parallel.h
+ * @brief Multi-threaded traversal of the tree based containers
+ * @details The key order is cut into one contiguous slice per thread with
+ * nth(), which costs O(log n) thanks to the subtree counts, so every slice
+ * holds the same number of entries whatever the shape of the tree. Each
+ * thread then walks its own slice with the ordinary iterator.
+ *
+ * The container must not be modified while a traversal runs. Splay
+ * containers count as modified by find() and contains(), so fn must not
+ * look them up either. fn gets `const Entry &`: `entry.key_`, plus
+ * `entry.value_` for the maps. If fn throws on some thread, the other
+ * slices still finish and the first exception is rethrown afterwards.
+ */
+
+namespace s21 {
+
+namespace parallel_detail {
+
+// Below this many entries per thread, starting a thread costs more than
+// walking the entries
+constexpr std::size_t kMinSlice = 4096;
+
+inline unsigned SliceCount(std::size_t size, unsigned threads) {
+  if (threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+  std::size_t useful = std::max<std::size_t>(1, size / kMinSlice);
+  return static_cast<unsigned>(std::min<std::size_t>(threads, useful));
+}
+
+// The entry behind it, without the node's links
+template <typename Container, typename Iterator>
+const typename Container::Entry &EntryOf(Iterator it) {
+  return *it.operator->();
+}
+
+// Runs body(slice) for every slice in [0, slices), slice 0 on the calling
+// thread and each of the others on a thread of its own. Slices that find
+// no thread, because the system refuses to start more, run on the calling
+// thread as well.
+template <typename Body>
+void RunSlices(unsigned slices, Body body) {
+  std::vector<std::exception_ptr> errors(slices);
+  auto run = [&errors, &body](unsigned slice) {
+    try {
+      body(slice);
+    } catch (...) {
+      errors[slice] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(slices - 1);
+  unsigned started = 1;
+  try {
+    for (; started < slices; ++started) workers.emplace_back(run, started);
+  } catch (const std::system_error &) {
+    // The workers already running are joined below as usual
+  }
+  for (unsigned i = started; i < slices; ++i) run(i);
+  run(0);
+  for (auto &worker : workers) worker.join();
+  for (auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+// Runs body(slice, first, last) for every slice of the key order
+template <typename Container, typename Body>
+void ForEachSlice(const Container &container, unsigned slices, Body body) {
+  std::size_t size = container.size();
+  std::vector<decltype(container.begin())> bounds;
+  bounds.reserve(slices + 1);
+  for (unsigned i = 0; i < slices; ++i) {
+    bounds.push_back(container.nth(size * i / slices));
+  }
+  bounds.push_back(container.end());
+  RunSlices(slices, [&bounds, &body](unsigned slice) {
+    body(slice, bounds[slice], bounds[slice + 1]);
+  });
+}
+
+}  // namespace parallel_detail
+
+// Calls fn(entry) for every entry of container, in key order within a
+// slice but with no order between slices. threads == 0 uses every core.
+template <typename Container, typename Fn>
+void parallel_for_each(const Container &container, Fn fn,
+                       unsigned threads = 0) {
+  if (container.size() == 0) return;
+  unsigned slices = parallel_detail::SliceCount(container.size(), threads);
+  parallel_detail::ForEachSlice(
+      container, slices, [&fn](unsigned, auto first, auto last) {
+        for (; first != last; ++first) {
+          fn(parallel_detail::EntryOf<Container>(first));
+        }
+      });
+}
+
+// Ordered reduction: returns
+//   combine(...combine(combine(init, transform(e0)), transform(e1))...)
+// over the entries in key order. combine must be associative, it need
+// not be commutative: the partial results of the slices are combined
+// left to right.
+template <typename Container, typename T, typename Transform,
+          typename Combine>
+T parallel_reduce(const Container &container, T init, Transform transform,
+                  Combine combine, unsigned threads = 0) {
+  if (container.size() == 0) return init;
+  unsigned slices = parallel_detail::SliceCount(container.size(), threads);
+  std::vector<T> partial(slices, init);
+  parallel_detail::ForEachSlice(
+      container, slices,
+      [&partial, &transform, &combine](unsigned slice, auto first,
+                                       auto last) {
+        // Every slice is non-empty: slices never exceeds the size
+        T acc = transform(parallel_detail::EntryOf<Container>(first));
+        for (++first; first != last; ++first) {
+          acc = combine(std::move(acc),
+                        transform(parallel_detail::EntryOf<Container>(first)));
+        }
+        partial[slice] = std::move(acc);
+      });
+  for (auto &value : partial) {
+    init = combine(std::move(init), std::move(value));
+  }
+  return init;
+}
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_PARALLEL_H
@@ -0,0 +1,319 @@
+#ifndef COMPONENTS_S21_PERSISTENT_MAP_H
+#define COMPONENTS_S21_PERSISTENT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+/**
+ * Sorted map whose nodes are never modified once built. An update copies
+ * the O(log n) nodes on the path to the changed key and shares every other
+ * node with the previous version, so copying the map, or taking a
+ * snapshot(), is O(1): it is one more reference to the root. A node is
+ * freed when the last version that uses it goes away.
+ *
+ * The tree is an AVL tree, whose rebalancing after an insert or erase only
+ * touches the nodes of the copied path. Keys and mapped values on that
+ * path are copied, so large values are best held through a shared_ptr.
+ *
+ * Threads: updates must come from one writer at a time. Any number of
+ * readers may call snapshot() while the writer works and then use their
+ * snapshot without any locking; other calls on the live map are for the
+ * writer only.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class persistent_map {
+ private:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+
+  struct Node;
+  using NodePtr = std::shared_ptr<const Node>;
+
+  struct Node {
+    const Key key_;
+    const Value value_;
+    NodePtr left_;
+    NodePtr right_;
+    size_type count_;
+    int height_;
+
+    Node(const Key &key, const Value &value, NodePtr left, NodePtr right)
+        : key_(key),
+          value_(value),
+          left_(std::move(left)),
+          right_(std::move(right)),
+          count_(Count(left_) + Count(right_) + 1),
+          height_(std::max(Height(left_), Height(right_)) + 1) {}
+  };
+
+ public:
+  // Walks one version in key order. The iterator borrows that version's
+  // nodes: the map or snapshot it came from must outlive it.
+  class const_iterator {
+   private:
+    // The current node on top, below it the ancestors still to be visited
+    std::vector<const Node *> path_;
+    friend class persistent_map;
+
+    void PushLeftSpine(const Node *node) {
+      for (; node != nullptr; node = node->left_.get()) path_.push_back(node);
+    }
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Node *;
+    using reference = const Key &;
+
+    const_iterator() = default;
+
+    const Key &operator*() const { return path_.back()->key_; }
+    const Node *operator->() const { return path_.back(); }
+
+    const_iterator &operator++() {
+      const Node *current = path_.back();
+      path_.pop_back();
+      PushLeftSpine(current->right_.get());
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return path_.empty() ? other.path_.empty()
+                           : !other.path_.empty() &&
+                                 path_.back() == other.path_.back();
+    }
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+  };  // end class const_iterator
+
+  persistent_map() = default;
+  explicit persistent_map(const Compare &compare) : compare_(compare) {}
+  persistent_map(std::initializer_list<value_type> const &key_value_pairs) {
+    for (const auto &kvp : key_value_pairs) insert(kvp);
+  }
+  // Copies share every node, see snapshot()
+  persistent_map(const persistent_map &other)
+      : root_(std::atomic_load(&other.root_)), compare_(other.compare_) {}
+  persistent_map(persistent_map &&other) noexcept
+      : root_(std::move(other.root_)), compare_(other.compare_) {}
+  persistent_map &operator=(const persistent_map &other) {
+    if (this != &other) {
+      compare_ = other.compare_;
+      Publish(std::atomic_load(&other.root_));
+    }
+    return *this;
+  }
+  persistent_map &operator=(persistent_map &&other) noexcept {
+    if (this != &other) {
+      compare_ = other.compare_;
+      Publish(std::move(other.root_));
+    }
+    return *this;
+  }
+
+  // O(1) frozen copy of the current version, safe to take while another
+  // thread updates this map
+  persistent_map snapshot() const { return *this; }
+
+  const_iterator begin() const {
+    const_iterator it;
+    it.PushLeftSpine(root_.get());
+    return it;
+  }
+  const_iterator end() const { return const_iterator(); }
+
+  size_type size() const { return Count(root_); }
+  bool empty() const { return root_ == nullptr; }
+
+  const_iterator find(const key_type &key) const {
+    const_iterator it;
+    for (const Node *node = root_.get(); node != nullptr;) {
+      if (compare_(key, node->key_)) {
+        it.path_.push_back(node);
+        node = node->left_.get();
+      } else if (compare_(node->key_, key)) {
+        node = node->right_.get();
+      } else {
+        it.path_.push_back(node);
+        return it;
+      }
+    }
+    return end();
+  }
+
+  bool contains(const key_type &key) const { return FindNode(key) != nullptr; }
+
+  const mapped_type &at(const key_type &key) const {
+    const Node *node = FindNode(key);
+    if (node == nullptr) {
+      throw std::out_of_range("persistent_map::at: key not found");
+    }
+    return node->value_;
+  }
+
+  // Leaves the map unchanged, and allocates nothing, if the key is present
+  bool insert(const value_type &kvp) {
+    bool inserted = false;
+    NodePtr root = Insert(root_, kvp.first, kvp.second, false, &inserted);
+    if (inserted) Publish(std::move(root));
+    return inserted;
+  }
+
+  // Returns true if the key was new
+  bool insert_or_assign(const key_type &key, const mapped_type &value) {
+    bool inserted = false;
+    Publish(Insert(root_, key, value, true, &inserted));
+    return inserted;
+  }
+
+  size_type erase(const key_type &key) {
+    bool erased = false;
+    NodePtr root = Erase(root_, key, &erased);
+    if (!erased) return 0;
+    Publish(std::move(root));
+    return 1;
+  }
+
+  void clear() { Publish(nullptr); }
+
+  void swap(persistent_map &other) {
+    NodePtr root = std::atomic_load(&other.root_);
+    other.Publish(std::atomic_load(&root_));
+    Publish(std::move(root));
+    std::swap(compare_, other.compare_);
+  }
+
+ private:
+  static size_type Count(const NodePtr &node) {
+    return node ? node->count_ : 0;
+  }
+  static int Height(const NodePtr &node) { return node ? node->height_ : 0; }
+
+  static NodePtr MakeNode(const Key &key, const Value &value, NodePtr left,
+                          NodePtr right) {
+    return std::make_shared<const Node>(key, value, std::move(left),
+                                        std::move(right));
+  }
+
+  // Builds the node (key, value, left, right), rotating once or twice if the
+  // heights of left and right differ by two. Only new nodes are created: the
+  // children passed in are shared, never changed.
+  static NodePtr Balance(const Key &key, const Value &value,
+                         const NodePtr &left, const NodePtr &right) {
+    int left_height = Height(left);
+    int right_height = Height(right);
+    if (left_height > right_height + 1) {
+      if (Height(left->left_) >= Height(left->right_)) {
+        return MakeNode(left->key_, left->value_, left->left_,
+                        MakeNode(key, value, left->right_, right));
+      }
+      const NodePtr &middle = left->right_;
+      return MakeNode(
+          middle->key_, middle->value_,
+          MakeNode(left->key_, left->value_, left->left_, middle->left_),
+          MakeNode(key, value, middle->right_, right));
+    }
+    if (right_height > left_height + 1) {
+      if (Height(right->right_) >= Height(right->left_)) {
+        return MakeNode(right->key_, right->value_,
+                        MakeNode(key, value, left, right->left_),
+                        right->right_);
+      }
+      const NodePtr &middle = right->left_;
+      return MakeNode(
+          middle->key_, middle->value_,
+          MakeNode(key, value, left, middle->left_),
+          MakeNode(right->key_, right->value_, middle->right_, right->right_));
+    }
+    return MakeNode(key, value, left, right);
+  }
+
+  NodePtr Insert(const NodePtr &node, const Key &key, const Value &value,
+                 bool assign, bool *inserted) const {
+    if (node == nullptr) {
+      *inserted = true;
+      return MakeNode(key, value, nullptr, nullptr);
+    }
+    if (compare_(key, node->key_)) {
+      NodePtr left = Insert(node->left_, key, value, assign, inserted);
+      if (left == node->left_) return node;
+      return Balance(node->key_, node->value_, left, node->right_);
+    }
+    if (compare_(node->key_, key)) {
+      NodePtr right = Insert(node->right_, key, value, assign, inserted);
+      if (right == node->right_) return node;
+      return Balance(node->key_, node->value_, node->left_, right);
+    }
+    if (!assign) return node;
+    return MakeNode(node->key_, value, node->left_, node->right_);
+  }
+
+  NodePtr Erase(const NodePtr &node, const Key &key, bool *erased) const {
+    if (node == nullptr) return nullptr;
+    if (compare_(key, node->key_)) {
+      NodePtr left = Erase(node->left_, key, erased);
+      if (!*erased) return node;
+      return Balance(node->key_, node->value_, left, node->right_);
+    }
+    if (compare_(node->key_, key)) {
+      NodePtr right = Erase(node->right_, key, erased);
+      if (!*erased) return node;
+      return Balance(node->key_, node->value_, node->left_, right);
+    }
+    *erased = true;
+    if (node->left_ == nullptr) return node->right_;
+    if (node->right_ == nullptr) return node->left_;
+    // The successor takes the place of the erased node
+    const Node *successor = node->right_.get();
+    while (successor->left_) successor = successor->left_.get();
+    return Balance(successor->key_, successor->value_, node->left_,
+                   EraseMin(node->right_));
+  }
+
+  static NodePtr EraseMin(const NodePtr &node) {
+    if (node->left_ == nullptr) return node->right_;
+    return Balance(node->key_, node->value_, EraseMin(node->left_),
+                   node->right_);
+  }
+
+  const Node *FindNode(const key_type &key) const {
+    const Node *node = root_.get();
+    while (node != nullptr) {
+      if (compare_(key, node->key_)) {
+        node = node->left_.get();
+      } else if (compare_(node->key_, key)) {
+        node = node->right_.get();
+      } else {
+        break;
+      }
+    }
+    return node;
+  }
+
+  // Makes root the current version for snapshot() callers on other threads
+  void Publish(NodePtr root) { std::atomic_store(&root_, std::move(root)); }
+
+  NodePtr root_;
+  Compare compare_;
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_PERSISTENT_MAP_H
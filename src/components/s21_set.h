@@ -4,100 +4,304 @@
 #include "s21_sorted_container.h"
 
 namespace s21 {
-template <typename Key>
-class set : public BinaryTree<Key, Key> {
+template <typename Key, typename Compare = std::less<Key>,
+          template <typename> class Storage = HeapStorage,
+          typename Balance = RedBlackBalance>
+class set : public BinaryTree<Key, void, Compare, Storage, Balance> {
  private:
   using key_type = Key;
+  using Tree = BinaryTree<key_type, void, Compare, Storage, Balance>;
   using value_type = Key;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using const_iterator =
-      typename BinaryTree<key_type, value_type>::const_iterator;
+  using const_iterator = typename Tree::const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
   using size_type = size_t;
+  using node_type = typename Tree::NodeHandle;
+  using insert_return_type = typename Tree::InsertReturn;
+  using range_view = typename Tree::RangeView;
+  using finger_type = typename Tree::Finger;
+
+ protected:
+  using Node = typename Tree::Node;
 
  public:
-  set() : BinaryTree<key_type, value_type>(){};
+  set() : Tree(){};
   set(std::initializer_list<value_type> const &items)
-      : BinaryTree<key_type, value_type>() {
-    for (auto num : items) {
-      std::cout << num << " ";
-      this->AddNode(num, num);
-    }
-    std::cout << std::endl;
+      : set(items.begin(), items.end()) {}
+  explicit set(const Compare &compare) : Tree(compare) {}
+  template <typename InputIt>
+  set(InputIt first, InputIt last, const Compare &compare = Compare())
+      : Tree(compare) {
+    assign(first, last);
   }
-  set(const set &s) : BinaryTree<key_type, value_type>() {
-    this->DestroyTree(this->root_);
-    this->root_ = this->CopyTree(s.root_, nullptr);
+  set(const set &s) : Tree() {
+    this->CopyFrom(s);
   };
-  set(set &&s) noexcept : BinaryTree<key_type, value_type>() {
-    this->root_ = s.root_;
-    s.root_ = nullptr;
-  }
-  ~set() {
-    this->DestroyTree(this->root_);
-    this->root_ = nullptr;
+  set(set &&s) noexcept : Tree() {
+    this->MoveFrom(s);
   }
+  ~set() { this->Clear(); }
   set &operator=(const set &s) {
     if (this != &s) {
-      this->DestroyTree(this->root_);
-      this->root_ = this->CopyTree(s.root_, nullptr);
+      this->CopyFrom(s);
     }
     return *this;
   }
 
   set &operator=(set &&s) noexcept {
     if (this != &s) {
-      this->DestroyTree(this->root_);
-      this->root_ = s.root_;
-      s.root_ = nullptr;
+      this->MoveFrom(s);
     }
     return *this;
   }
 
-  const_iterator begin() const {
-    return BinaryTree<key_type, value_type>::Begin();
+  const_iterator begin() const { return Tree::Begin(); }
+  const_iterator end() const { return Tree::End(); }
+  // begin(), rbegin() and --end() are O(1): the tree caches both ends
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
   }
-  const_iterator end() const { return BinaryTree<key_type, value_type>::End(); }
-
-  size_type size() {
-    this->counter_ = 0;
-    this->PrintTree();
-    this->CountNodes(this->root_);
-    return this->counter_;
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
   }
 
+  size_type size() const { return this->Size(); }
+
   bool empty() { return this->TreeEmpty(); }
 
-  void clear() {
-    this->DestroyTree(this->root_);
-    this->root_ = nullptr;
-  }
+  void clear() { this->Clear(); }
 
   std::pair<const_iterator, bool> insert(const value_type &value) {
-    return this->AddNode(value, value);
+    return this->AddNode(value);
+  }
+  insert_return_type insert(node_type &&node) {
+    return this->AddNode(std::move(node));
   }
 
-  void erase(const_iterator pos) { this->Erase(pos); }
-  const_iterator find(const key_type &key) {
+  node_type extract(const_iterator pos) { return this->Extract(pos); }
+  node_type extract(const key_type &key) { return this->Extract(find(key)); }
+
+  // Replaces the contents with [first, last); O(n) for sorted input
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    this->InsertBatch(
+        this->MakeBatch(first, last, [this](const value_type &key) {
+          return this->CreateNode(key);
+        }));
+  }
+
+  template <typename... Args>
+  std::vector<std::pair<const_iterator, bool>> insert_many(Args &&...args) {
+    std::vector<Node *> batch = this->MakePackBatch(
+        [this](const auto &key) { return this->CreateNode(key); }, args...);
+    std::vector<std::pair<const_iterator, bool>> result;
+    this->InsertBatch(batch, &result);
+    return result;
+  }
+
+  const_iterator erase(const_iterator pos) { return this->Erase(pos); }
+  // Removes [first, last) in O(k log n) for k removed keys
+  const_iterator erase(const_iterator first, const_iterator last) {
+    return this->EraseRange(first, last);
+  }
+  size_type erase(const key_type &key) {
+    const_iterator pos = find(key);
+    if (pos == end()) return 0;
+    erase(pos);
+    return 1;
+  }
+
+  template <typename K, typename C, template <typename> class S, typename B,
+            typename Pred>
+  friend size_t erase_if(set<K, C, S, B> &container, Pred pred);
+  // Under SplayBalance a lookup moves the key found to the root, so a
+  // splay set is only searched through a non-const reference
+  const_iterator find(const key_type &key) const {
+    static_assert(!Balance::kSelfAdjusting,
+                  "a splay set restructures on find, use a non-const one");
     return this->FindNode(this->root_, key);
   }
+  const_iterator find(const key_type &key) {
+    return this->AccessNode(this->root_, key);
+  }
 
+  bool contains(const key_type &key) const {
+    static_assert(!Balance::kSelfAdjusting,
+                  "a splay set restructures on find, use a non-const one");
+    return this->Contains(this->root_, key);
+  }
   bool contains(const key_type &key) {
+    return this->AccessNode(this->root_, key) != this->end();
+  }
+
+  // Looks up all keys of [first, last) at once, overlapping the cache
+  // misses of up to 16 descents; one result per key, in input order
+  template <typename ForwardIt>
+  std::vector<const_iterator> find_many(ForwardIt first,
+                                        ForwardIt last) const {
+    std::vector<const_iterator> result;
+    result.reserve(std::distance(first, last));
+    this->FindBatch(first, last, [this, &result](size_type, Node *node) {
+      result.push_back(this->MakeIterator(node));
+    });
+    return result;
+  }
+  template <typename ForwardIt>
+  std::vector<bool> contains_many(ForwardIt first, ForwardIt last) const {
+    std::vector<bool> result;
+    result.reserve(std::distance(first, last));
+    this->FindBatch(first, last, [&result](size_type, Node *node) {
+      result.push_back(node != nullptr);
+    });
+    return result;
+  }
+
+  // Bounds are found in one O(log n) descent, scanning the range then
+  // costs O(1) amortized per key
+  const_iterator lower_bound(const key_type &key) const {
+    return this->LowerBound(key);
+  }
+  const_iterator upper_bound(const key_type &key) const {
+    return this->UpperBound(key);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    return this->EqualRange(key);
+  }
+  // Keys in [low, high), for use in range-based for
+  range_view range(const key_type &low, const key_type &high) const {
+    return this->Range(low, high);
+  }
+
+  // Heterogeneous lookup, enabled when Compare is transparent (such as
+  // std::less<>): e.g. a string_view is compared with string keys directly
+  // instead of being copied into a temporary key first
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) const {
+    static_assert(!Balance::kSelfAdjusting,
+                  "a splay set restructures on find, use a non-const one");
+    return this->FindNode(this->root_, key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) {
+    return this->AccessNode(this->root_, key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    static_assert(!Balance::kSelfAdjusting,
+                  "a splay set restructures on find, use a non-const one");
     return this->Contains(this->root_, key);
   }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) {
+    return this->AccessNode(this->root_, key) != this->end();
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator lower_bound(const K &key) const {
+    return this->LowerBound(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator upper_bound(const K &key) const {
+    return this->UpperBound(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+    return this->EqualRange(key);
+  }
+
+  Compare key_comp() const { return this->compare_; }
+
+  // A cursor whose lookups start from where the previous one ended
+  finger_type finger() const { return finger_type(*this); }
+
+  // Calls on_match(key, it) for every key of the sorted [first, last) that
+  // is present, walking both sequences in step through one finger
+  template <typename InputIt, typename OnMatch>
+  void merge_join(InputIt first, InputIt last, OnMatch on_match) const {
+    finger_type cursor = finger();
+    for (; first != last; ++first) {
+      const_iterator it = cursor.find(*first);
+      if (it != end()) on_match(*first, it);
+    }
+  }
+
+  // Order statistics, O(log n) thanks to the per-node subtree counts
+  const_iterator nth(size_type k) const { return this->Select(k); }
+  size_type rank(const key_type &key) const { return this->Rank(key); }
 
-  void swap(set &other) { return this->Swap(other.root_); }
+  void swap(set &other) { this->Swap(other); }
 
-  void merge(set &other) {
-    this->Merge(other.root_);
-    this->PrintTree();
-    std::cout << "*****************" << std::endl;
-    other.PrintTree();
+  void merge(set &other) { this->Merge(other); }
+
+  // In-place set algebra, O(n + m) each. Our nodes are reused and, for
+  // unite() and toggle(), other's nodes are moved in and other is left
+  // empty; nothing is allocated except between two pools.
+  void unite(set &other) { this->CombineFrom(other, true); }
+  // Keeps the keys present in only one of the two sets
+  void toggle(set &other) { this->CombineFrom(other, false); }
+  void intersect(const set &other) { KeepIf(other, true); }
+  void subtract(const set &other) {
+    if (this == &other) {
+      clear();
+      return;
+    }
+    KeepIf(other, false);
+  }
+
+  // Leaves the keys less than key here and returns the rest. Nodes are
+  // relinked, not reallocated, in O(log n) (a pooled container recreates
+  // the moved nodes in the pool of the returned one).
+  set split(const key_type &key) {
+    set upper(this->compare_);
+    this->SplitInto(key, upper);
+    return upper;
+  }
+  // Appends other, whose keys must all be greater than ours, in O(log n)
+  // and leaves it empty; overlapping key ranges fall back to merge()
+  void join(set &other) { this->JoinFrom(other); }
+  void join(set &&other) { this->JoinFrom(other); }
+  // Moves [first, last) out into a new container with two splits and a join
+  set extract(const_iterator first, const_iterator last) {
+    set extracted(this->compare_);
+    this->ExtractRange(first, last, extracted);
+    return extracted;
   }
 
   void print() { this->PrintTree(); }
+
+ private:
+  // Frees our keys whose presence in other differs from in_other, walking
+  // other alongside the compaction pass
+  void KeepIf(const set &other, bool in_other) {
+    const_iterator probe = other.begin();
+    const_iterator stop = other.end();
+    const Compare &less = this->compare_;
+    this->Compact([&probe, stop, &less, in_other](const Node *node) {
+      while (probe != stop && less(*probe, node->key_)) ++probe;
+      bool found = probe != stop && !less(node->key_, *probe);
+      return found != in_other;
+    });
+  }
 };
 
+// Removes the keys for which pred(entry) holds (entry.key_ is the key) and
+// returns how many. One O(n) pass frees them and rebuilds the survivors
+// into a balanced tree, with no per-node rebalancing.
+template <typename Key, typename Compare, template <typename> class Storage,
+          typename Balance, typename Pred>
+size_t erase_if(set<Key, Compare, Storage, Balance> &container, Pred pred) {
+  return container.EraseIf(pred);
+}
+
 }  // namespace s21
 
 #endif  // COMPONENTS_S21_SET_H
\ No newline at end of file
@@ -0,0 +1,260 @@
+#ifndef COMPONENTS_S21_SET_ALGEBRA_H
+#define COMPONENTS_S21_SET_ALGEBRA_H
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "s21_parallel.h"
+#include "s21_set.h"
+
+/**
+ * @file s21_set_algebra.h
+ * @brief Union, intersection, difference and symmetric difference of sets
+ * @details Each function merge-walks the two sets in key order, O(n + m),
+ * and builds the result from the picked keys, which arrive sorted, with
+ * one O(k) bulk build instead of k inserts. When one side of an
+ * intersection or difference is much larger than the other, the smaller
+ * one is walked and the larger probed with a finger, O(n log(m / n)).
+ *
+ * The parallel_ versions cut the key range into one slice per thread (see
+ * s21_parallel.h) and walk the slices concurrently; the final build stays
+ * on the calling thread. The in-place versions are set members: unite(),
+ * intersect(), subtract() and toggle().
+ */
+
+namespace s21 {
+
+namespace set_algebra_detail {
+
+// Which keys an operation keeps: those only in the left set, only in the
+// right one, or in both
+struct Operation {
+  bool left_only;
+  bool right_only;
+  bool both;
+};
+
+constexpr Operation kUnion{true, true, true};
+constexpr Operation kIntersection{false, false, true};
+constexpr Operation kDifference{true, false, false};
+constexpr Operation kSymmetricDifference{true, true, false};
+
+// Walking the smaller set with a finger into the larger one pays off past
+// this size ratio
+constexpr std::size_t kFingerRatio = 8;
+
+// Appends to picked the iterators of the keys op keeps from
+// [left, left_end) and [right, right_end)
+template <typename Iterator, typename Compare>
+void MergeWalk(Iterator left, Iterator left_end, Iterator right,
+               Iterator right_end, const Compare &less, Operation op,
+               std::vector<Iterator> &picked) {
+  while (left != left_end && right != right_end) {
+    if (less(*left, *right)) {
+      if (op.left_only) picked.push_back(left);
+      ++left;
+    } else if (less(*right, *left)) {
+      if (op.right_only) picked.push_back(right);
+      ++right;
+    } else {
+      if (op.both) picked.push_back(left);
+      ++left;
+      ++right;
+    }
+  }
+  if (op.left_only) {
+    for (; left != left_end; ++left) picked.push_back(left);
+  }
+  if (op.right_only) {
+    for (; right != right_end; ++right) picked.push_back(right);
+  }
+}
+
+// Presents picked iterators as their keys, so the set range constructor
+// reads them without an intermediate copy of every key
+template <typename Iterator>
+class KeyIterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename std::iterator_traits<Iterator>::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const value_type *;
+  using reference = const value_type &;
+
+  explicit KeyIterator(const Iterator *at) : at_(at) {}
+
+  reference operator*() const { return **at_; }
+  KeyIterator &operator++() {
+    ++at_;
+    return *this;
+  }
+  KeyIterator operator++(int) {
+    KeyIterator tmp(*this);
+    ++at_;
+    return tmp;
+  }
+  bool operator==(const KeyIterator &other) const { return at_ == other.at_; }
+  bool operator!=(const KeyIterator &other) const { return at_ != other.at_; }
+
+ private:
+  const Iterator *at_;
+};
+
+// Strictly increasing keys into an empty set are linked in O(k)
+template <typename Set, typename Iterator>
+Set BuildFromPicked(const std::vector<Iterator> &picked,
+                    const Set &like) {
+  return Set(KeyIterator<Iterator>(picked.data()),
+             KeyIterator<Iterator>(picked.data() + picked.size()),
+             like.key_comp());
+}
+
+template <typename Set>
+Set Combine(const Set &left, const Set &right, Operation op) {
+  using Iterator = decltype(left.begin());
+  std::vector<Iterator> picked;
+  bool probe_right = !op.right_only &&
+                     right.size() / kFingerRatio > left.size();
+  bool probe_left = op.both && !op.left_only &&
+                    left.size() / kFingerRatio > right.size();
+  if (probe_right) {
+    // Intersection or difference with a much larger right side
+    auto finger = right.finger();
+    for (auto it = left.begin(); it != left.end(); ++it) {
+      if (finger.contains(*it) == op.both) picked.push_back(it);
+    }
+  } else if (probe_left) {
+    // Intersection with a much larger left side
+    auto finger = left.finger();
+    for (auto it = right.begin(); it != right.end(); ++it) {
+      auto found = finger.find(*it);
+      if (found != left.end()) picked.push_back(found);
+    }
+  } else {
+    MergeWalk(left.begin(), left.end(), right.begin(), right.end(),
+              left.key_comp(), op, picked);
+  }
+  return BuildFromPicked(picked, left);
+}
+
+template <typename Set>
+Set ParallelCombine(const Set &left, const Set &right, Operation op,
+                    unsigned threads) {
+  // Slice by the larger set, cut the other one at the same keys
+  const Set &sliced = left.size() >= right.size() ? left : right;
+  const Set &other = &sliced == &left ? right : left;
+  unsigned slices = parallel_detail::SliceCount(sliced.size(), threads);
+  if (slices <= 1) return Combine(left, right, op);
+
+  using Iterator = decltype(left.begin());
+  std::vector<Iterator> sliced_bounds{sliced.begin()};
+  std::vector<Iterator> other_bounds{other.begin()};
+  for (unsigned i = 1; i < slices; ++i) {
+    sliced_bounds.push_back(sliced.nth(sliced.size() * i / slices));
+    other_bounds.push_back(other.lower_bound(*sliced_bounds.back()));
+  }
+  sliced_bounds.push_back(sliced.end());
+  other_bounds.push_back(other.end());
+
+  bool left_sliced = &sliced == &left;
+  const auto &left_bounds = left_sliced ? sliced_bounds : other_bounds;
+  const auto &right_bounds = left_sliced ? other_bounds : sliced_bounds;
+  std::vector<std::vector<Iterator>> parts(slices);
+  parallel_detail::RunSlices(slices, [&](unsigned slice) {
+    MergeWalk(left_bounds[slice], left_bounds[slice + 1], right_bounds[slice],
+              right_bounds[slice + 1], left.key_comp(), op, parts[slice]);
+  });
+
+  std::vector<Iterator> picked;
+  std::size_t total = 0;
+  for (const auto &part : parts) total += part.size();
+  picked.reserve(total);
+  for (const auto &part : parts) {
+    picked.insert(picked.end(), part.begin(), part.end());
+  }
+  return BuildFromPicked(picked, left);
+}
+
+}  // namespace set_algebra_detail
+
+// The keys in either set
+template <typename Key, typename Compare, template <typename> class Storage,
+          typename Balance>
+set<Key, Compare, Storage, Balance> set_union(
+    const set<Key, Compare, Storage, Balance> &left,
+    const set<Key, Compare, Storage, Balance> &right) {
+  return set_algebra_detail::Combine(left, right,
+                                     set_algebra_detail::kUnion);
+}
+
+// The keys in both sets
+template <typename Key, typename Compare, template <typename> class Storage,
+          typename Balance>
+set<Key, Compare, Storage, Balance> set_intersection(
+    const set<Key, Compare, Storage, Balance> &left,
+    const set<Key, Compare, Storage, Balance> &right) {
+  return set_algebra_detail::Combine(left, right,
+                                     set_algebra_detail::kIntersection);
+}
+
+// The keys of left that are not in right
+template <typename Key, typename Compare, template <typename> class Storage,
+          typename Balance>
+set<Key, Compare, Storage, Balance> set_difference(
+    const set<Key, Compare, Storage, Balance> &left,
+    const set<Key, Compare, Storage, Balance> &right) {
+  return set_algebra_detail::Combine(left, right,
+                                     set_algebra_detail::kDifference);
+}
+
+// The keys in exactly one of the sets
+template <typename Key, typename Compare, template <typename> class Storage,
+          typename Balance>
+set<Key, Compare, Storage, Balance> set_symmetric_difference(
+    const set<Key, Compare, Storage, Balance> &left,
+    const set<Key, Compare, Storage, Balance> &right) {
+  return set_algebra_detail::Combine(
+      left, right, set_algebra_detail::kSymmetricDifference);
+}
+
+// Multi-threaded versions; threads == 0 uses every core
+template <typename Key, typename Compare, template <typename> class Storage,
+          typename Balance>
+set<Key, Compare, Storage, Balance> parallel_set_union(
+    const set<Key, Compare, Storage, Balance> &left,
+    const set<Key, Compare, Storage, Balance> &right, unsigned threads = 0) {
+  return set_algebra_detail::ParallelCombine(
+      left, right, set_algebra_detail::kUnion, threads);
+}
+
+template <typename Key, typename Compare, template <typename> class Storage,
+          typename Balance>
+set<Key, Compare, Storage, Balance> parallel_set_intersection(
+    const set<Key, Compare, Storage, Balance> &left,
+    const set<Key, Compare, Storage, Balance> &right, unsigned threads = 0) {
+  return set_algebra_detail::ParallelCombine(
+      left, right, set_algebra_detail::kIntersection, threads);
+}
+
+template <typename Key, typename Compare, template <typename> class Storage,
+          typename Balance>
+set<Key, Compare, Storage, Balance> parallel_set_difference(
+    const set<Key, Compare, Storage, Balance> &left,
+    const set<Key, Compare, Storage, Balance> &right, unsigned threads = 0) {
+  return set_algebra_detail::ParallelCombine(
+      left, right, set_algebra_detail::kDifference, threads);
+}
+
+template <typename Key, typename Compare, template <typename> class Storage,
+          typename Balance>
+set<Key, Compare, Storage, Balance> parallel_set_symmetric_difference(
+    const set<Key, Compare, Storage, Balance> &left,
+    const set<Key, Compare, Storage, Balance> &right, unsigned threads = 0) {
+  return set_algebra_detail::ParallelCombine(
+      left, right, set_algebra_detail::kSymmetricDifference, threads);
+}
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_SET_ALGEBRA_H
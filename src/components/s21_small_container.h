@@ -0,0 +1,408 @@
+#ifndef COMPONENTS_S21_SMALL_CONTAINER_H
+#define COMPONENTS_S21_SMALL_CONTAINER_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+namespace small_detail {
+
+// An entry of the inline array. Unlike the tree's node data its key is not
+// const, so shifting the array moves keys instead of copying them.
+template <typename Key, typename T>
+struct Slot {
+  Key key_;
+  T value_;
+};
+
+template <typename Key>
+struct Slot<Key, void> {
+  Key key_;
+};
+
+// What it->... exposes in both modes: the key, and the mapped value for
+// maps, whether they sit in an inline slot or in a tree node
+template <typename Key, typename T>
+struct EntryRef {
+  const Key &key_;
+  const T &value_;
+};
+
+template <typename Key>
+struct EntryRef<Key, void> {
+  const Key &key_;
+};
+
+}  // namespace small_detail
+
+/**
+ * Shared part of small_set and small_map. Up to N entries live in a sorted
+ * array inside the object itself, so a small container never allocates.
+ * Inserting one more key moves everything into a heap allocated Big
+ * (s21::set or s21::map) and from then on every call is forwarded to it;
+ * clear() goes back to the inline array.
+ *
+ * Inline iterators are plain pointers: unlike tree iterators they are
+ * invalidated by any insert or erase and by moving the container.
+ *
+ * Inserts, erases and moves shift inline entries by move construction,
+ * which cannot be undone halfway, so Key and T must be nothrow move
+ * constructible. std::string and the other standard types are.
+ */
+template <typename Key, typename T, std::size_t N, typename Compare,
+          typename Big>
+class SmallSortedContainer {
+  static_assert(N > 0, "use s21::set or s21::map for N == 0");
+
+ public:
+  using size_type = std::size_t;
+  using Entry = small_detail::EntryRef<Key, T>;
+
+ private:
+  using Slot = small_detail::Slot<Key, T>;
+  using BigIterator = decltype(std::declval<const Big &>().begin());
+  static_assert(std::is_nothrow_move_constructible_v<Slot>,
+                "small containers need keys and values that move without "
+                "throwing");
+
+ public:
+  class const_iterator {
+   private:
+    const Slot *slot_ = nullptr;  // null in tree mode
+    BigIterator node_{nullptr};
+    friend class SmallSortedContainer;
+
+    explicit const_iterator(const Slot *slot) : slot_(slot) {}
+    explicit const_iterator(BigIterator node) : node_(node) {}
+
+    // Keeps Entry alive for the duration of it->...
+    class Arrow {
+     public:
+      explicit Arrow(const Entry &entry) : entry_(entry) {}
+      const Entry *operator->() const { return &entry_; }
+
+     private:
+      Entry entry_;
+    };
+
+    // Views an inline slot or a tree node's data the same way
+    template <typename Stored>
+    static Entry View(const Stored &stored) {
+      if constexpr (std::is_void_v<T>) {
+        return Entry{stored.key_};
+      } else {
+        return Entry{stored.key_, stored.value_};
+      }
+    }
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Arrow;
+    using reference = const Key &;
+
+    const_iterator() = default;
+
+    const Key &operator*() const { return slot_ ? slot_->key_ : *node_; }
+    Arrow operator->() const {
+      return Arrow(slot_ ? View(*slot_) : View(*node_.operator->()));
+    }
+
+    const_iterator &operator++() {
+      slot_ ? static_cast<void>(++slot_) : static_cast<void>(++node_);
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+    const_iterator &operator--() {
+      slot_ ? static_cast<void>(--slot_) : static_cast<void>(--node_);
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator tmp(*this);
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return slot_ == other.slot_ && (slot_ || node_ == other.node_);
+    }
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+  };  // end class const_iterator
+
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  SmallSortedContainer() = default;
+  explicit SmallSortedContainer(const Compare &compare) : compare_(compare) {}
+  SmallSortedContainer(const SmallSortedContainer &other)
+      : compare_(other.compare_) {
+    CopyFrom(other);
+  }
+  SmallSortedContainer(SmallSortedContainer &&other) noexcept
+      : compare_(other.compare_) {
+    MoveFrom(other);
+  }
+  ~SmallSortedContainer() { clear(); }
+
+  SmallSortedContainer &operator=(const SmallSortedContainer &other) {
+    if (this != &other) {
+      clear();
+      compare_ = other.compare_;
+      CopyFrom(other);
+    }
+    return *this;
+  }
+  SmallSortedContainer &operator=(SmallSortedContainer &&other) noexcept {
+    if (this != &other) {
+      clear();
+      compare_ = other.compare_;
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  const_iterator begin() const {
+    return big_ ? const_iterator(big_->begin()) : const_iterator(Data());
+  }
+  const_iterator end() const {
+    return big_ ? const_iterator(big_->end()) : const_iterator(Data() + size_);
+  }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const { return big_ ? big_->size() : size_; }
+  bool empty() const { return size() == 0; }
+  // True while the entries still live in the inline array
+  bool is_inline() const { return big_ == nullptr; }
+
+  void clear() {
+    DestroyInline();
+    big_.reset();
+  }
+
+  // Inline entries are moved across, so this is O(N) rather than O(1)
+  void swap(SmallSortedContainer &other) noexcept {
+    SmallSortedContainer moved(std::move(other));
+    other = std::move(*this);
+    *this = std::move(moved);
+  }
+
+  const_iterator find(const Key &key) const {
+    if (big_) return const_iterator(big_->find(key));
+    size_type position = InlineLowerBound(key);
+    return HoldsKey(position, key) ? const_iterator(Data() + position)
+                                   : end();
+  }
+
+  bool contains(const Key &key) const {
+    if (big_) return big_->contains(key);
+    return HoldsKey(InlineLowerBound(key), key);
+  }
+
+  const_iterator lower_bound(const Key &key) const {
+    if (big_) return const_iterator(big_->lower_bound(key));
+    return const_iterator(Data() + InlineLowerBound(key));
+  }
+  const_iterator upper_bound(const Key &key) const {
+    if (big_) return const_iterator(big_->upper_bound(key));
+    return const_iterator(Data() + InlineUpperBound(key));
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key &key) const {
+    if (big_) {
+      auto [first, last] = big_->equal_range(key);
+      return {const_iterator(first), const_iterator(last)};
+    }
+    size_type position = InlineLowerBound(key);
+    return {const_iterator(Data() + position),
+            const_iterator(Data() + position + HoldsKey(position, key))};
+  }
+
+  // Returns the entry that followed pos
+  const_iterator erase(const_iterator pos) {
+    if (big_) return const_iterator(big_->erase(pos.node_));
+    return erase(pos, std::next(pos));
+  }
+
+  const_iterator erase(const_iterator first, const_iterator last) {
+    if (big_) return const_iterator(big_->erase(first.node_, last.node_));
+    Slot *slots = Data();
+    size_type from = first.slot_ - slots;
+    size_type to = last.slot_ - slots;
+    for (size_type i = from; i < to; ++i) slots[i].~Slot();
+    for (size_type i = to; i < size_; ++i) {
+      new (slots + i - (to - from)) Slot(std::move(slots[i]));
+      slots[i].~Slot();
+    }
+    size_ -= to - from;
+    return const_iterator(slots + from);
+  }
+
+  size_type erase(const Key &key) {
+    const_iterator it = find(key);
+    if (it == end()) return 0;
+    erase(it);
+    return 1;
+  }
+
+  Compare key_comp() const { return compare_; }
+
+ protected:
+  // Builds the entry from key and args unless key is already present
+  template <typename... Args>
+  std::pair<const_iterator, bool> Emplace(const Key &key, Args &&...args) {
+    if (big_) {
+      auto [it, inserted] = BigEmplace(key, std::forward<Args>(args)...);
+      return {const_iterator(it), inserted};
+    }
+    size_type position = InlineLowerBound(key);
+    if (HoldsKey(position, key)) {
+      return {const_iterator(Data() + position), false};
+    }
+    if (size_ == N) {
+      Spill();
+      return Emplace(key, std::forward<Args>(args)...);
+    }
+    // Built first so a throwing constructor leaves the array untouched
+    Slot slot = MakeSlot(key, std::forward<Args>(args)...);
+    Slot *slots = Data();
+    for (size_type i = size_; i > position; --i) {
+      new (slots + i) Slot(std::move(slots[i - 1]));
+      slots[i - 1].~Slot();
+    }
+    new (slots + position) Slot(std::move(slot));
+    ++size_;
+    return {const_iterator(slots + position), true};
+  }
+
+ private:
+  template <typename... Args>
+  static Slot MakeSlot(const Key &key, Args &&...args) {
+    if constexpr (std::is_void_v<T>) {
+      return Slot{key};
+    } else {
+      return Slot{key, T(std::forward<Args>(args)...)};
+    }
+  }
+
+  template <typename... Args>
+  auto BigEmplace(const Key &key, Args &&...args) {
+    if constexpr (std::is_void_v<T>) {
+      return big_->insert(key);
+    } else {
+      return big_->try_emplace(key, std::forward<Args>(args)...);
+    }
+  }
+
+  // Branch free count of the smaller keys. N is small, so visiting every
+  // entry beats mispredicted early exits, and for arithmetic keys the
+  // compiler turns the loop into SIMD compares.
+  size_type InlineLowerBound(const Key &key) const {
+    const Slot *slots = Data();
+    size_type position = 0;
+    for (size_type i = 0; i < size_; ++i) {
+      position += compare_(slots[i].key_, key);
+    }
+    return position;
+  }
+
+  size_type InlineUpperBound(const Key &key) const {
+    const Slot *slots = Data();
+    size_type position = 0;
+    for (size_type i = 0; i < size_; ++i) {
+      position += !compare_(key, slots[i].key_);
+    }
+    return position;
+  }
+
+  bool HoldsKey(size_type position, const Key &key) const {
+    return position < size_ && !compare_(key, Data()[position].key_);
+  }
+
+  // Moves the inline entries into a new tree: keys are copied, mapped
+  // values moved. If the tree throws partway, the values it already took
+  // are moved back, so the container is left as it was.
+  void Spill() {
+    auto big = std::make_unique<Big>(compare_);
+    Slot *slots = Data();
+    if constexpr (std::is_void_v<T>) {
+      for (size_type i = 0; i < size_; ++i) big->insert(slots[i].key_);
+    } else {
+      try {
+        for (size_type i = 0; i < size_; ++i) {
+          big->try_emplace(big->end(), slots[i].key_,
+                           std::move(slots[i].value_));
+        }
+      } catch (...) {
+        // The tree holds a prefix of the slots, in the same order
+        Slot *slot = slots;
+        for (auto it = big->begin(); it != big->end(); ++it, ++slot) {
+          slot->value_ = std::move(const_cast<T &>(it->value_));
+        }
+        throw;
+      }
+    }
+    DestroyInline();
+    big_ = std::move(big);
+  }
+
+  void DestroyInline() {
+    Slot *slots = Data();
+    for (size_type i = 0; i < size_; ++i) slots[i].~Slot();
+    size_ = 0;
+  }
+
+  void CopyFrom(const SmallSortedContainer &other) {
+    if (other.big_) {
+      big_ = std::make_unique<Big>(*other.big_);
+      return;
+    }
+    // A throwing copy leaves the container empty, not half built
+    try {
+      for (; size_ < other.size_; ++size_) {
+        new (Data() + size_) Slot(other.Data()[size_]);
+      }
+    } catch (...) {
+      DestroyInline();
+      throw;
+    }
+  }
+
+  void MoveFrom(SmallSortedContainer &other) {
+    big_ = std::move(other.big_);
+    for (; size_ < other.size_; ++size_) {
+      new (Data() + size_) Slot(std::move(other.Data()[size_]));
+    }
+    other.DestroyInline();
+  }
+
+  Slot *Data() { return std::launder(reinterpret_cast<Slot *>(inline_)); }
+  const Slot *Data() const {
+    return std::launder(reinterpret_cast<const Slot *>(inline_));
+  }
+
+  alignas(Slot) unsigned char inline_[N * sizeof(Slot)];
+  size_type size_ = 0;
+  std::unique_ptr<Big> big_;
+  Compare compare_;
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_SMALL_CONTAINER_H
@@ -0,0 +1,81 @@
+#ifndef COMPONENTS_S21_SMALL_MAP_H
+#define COMPONENTS_S21_SMALL_MAP_H
+
+#include <stdexcept>
+
+#include "s21_map.h"
+#include "s21_small_container.h"
+
+namespace s21 {
+/**
+ * Map that keeps up to N entries inline and turns into an s21::map past
+ * that (see SmallSortedContainer). Iterators behave like s21::map ones:
+ * *it is the key and it->value_ the mapped value. The insert, lookup and
+ * erase overloads match s21::map's, so the two can be swapped with a
+ * using, except that inline iterators are invalidated by inserting or
+ * erasing.
+ */
+template <typename Key, typename Value, std::size_t N = 8,
+          typename Compare = std::less<Key>>
+class small_map : public SmallSortedContainer<Key, Value, N, Compare,
+                                              map<Key, Value, Compare>> {
+ private:
+  using Base =
+      SmallSortedContainer<Key, Value, N, Compare, map<Key, Value, Compare>>;
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using const_iterator = typename Base::const_iterator;
+
+ public:
+  small_map() = default;
+  explicit small_map(const Compare &compare) : Base(compare) {}
+  small_map(std::initializer_list<value_type> const &key_value_pairs)
+      : small_map(key_value_pairs.begin(), key_value_pairs.end()) {}
+  template <typename InputIt>
+  small_map(InputIt first, InputIt last, const Compare &compare = Compare())
+      : Base(compare) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  mapped_type &at(const key_type &key) {
+    const_iterator it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("small_map::at: key not found");
+    }
+    return const_cast<mapped_type &>(it->value_);
+  }
+
+  // Inserts a value-initialized mapped value if key is missing
+  mapped_type &operator[](const key_type &key) {
+    return const_cast<mapped_type &>(this->Emplace(key).first->value_);
+  }
+
+  std::pair<const_iterator, bool> insert(const value_type &kvp) {
+    return this->Emplace(kvp.first, kvp.second);
+  }
+  std::pair<const_iterator, bool> insert(const key_type &key,
+                                         const mapped_type &value) {
+    return this->Emplace(key, value);
+  }
+
+  template <typename... Args>
+  std::pair<const_iterator, bool> try_emplace(const key_type &key,
+                                              Args &&...args) {
+    return this->Emplace(key, std::forward<Args>(args)...);
+  }
+
+  template <typename M>
+  std::pair<const_iterator, bool> insert_or_assign(const key_type &key,
+                                                   M &&value) {
+    auto result = this->Emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      const_cast<mapped_type &>(result.first->value_) = std::forward<M>(value);
+    }
+    return result;
+  }
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_SMALL_MAP_H
@@ -0,0 +1,42 @@
+#ifndef COMPONENTS_S21_SMALL_SET_H
+#define COMPONENTS_S21_SMALL_SET_H
+
+#include "s21_set.h"
+#include "s21_small_container.h"
+
+namespace s21 {
+/**
+ * Set that keeps up to N keys inline and turns into an s21::set past that
+ * (see SmallSortedContainer). Meant for the many tiny sets where one heap
+ * node per key would dominate the cost. Lookups, bounds and erasing behave
+ * like s21::set ones, so the two can be swapped with a using, except that
+ * inline iterators are invalidated by inserting or erasing.
+ */
+template <typename Key, std::size_t N = 8, typename Compare = std::less<Key>>
+class small_set
+    : public SmallSortedContainer<Key, void, N, Compare, set<Key, Compare>> {
+ private:
+  using Base = SmallSortedContainer<Key, void, N, Compare, set<Key, Compare>>;
+  using key_type = Key;
+  using value_type = Key;
+  using const_iterator = typename Base::const_iterator;
+
+ public:
+  small_set() = default;
+  explicit small_set(const Compare &compare) : Base(compare) {}
+  small_set(std::initializer_list<value_type> const &items)
+      : small_set(items.begin(), items.end()) {}
+  template <typename InputIt>
+  small_set(InputIt first, InputIt last, const Compare &compare = Compare())
+      : Base(compare) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  std::pair<const_iterator, bool> insert(const value_type &value) {
+    return this->Emplace(value);
+  }
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_SMALL_SET_H
@@ -1,47 +1,129 @@
 #ifndef COMPONENTS_S21_SORTED_CONTAINER_H
 #define COMPONENTS_S21_SORTED_CONTAINER_H
 
+#include <algorithm>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
-template <typename Key, typename T>
+#include "s21_node_storage.h"
+#include "s21_tree_balance.h"
+
+/**
+ * Search tree shared by set and map, red-black unless Balance says
+ * otherwise (see s21_tree_balance.h). Keys are ordered by Compare, a
+ * strict weak ordering like std::less. Every descent asks it one question
+ * per level (is this node's key less than the one searched for?) and
+ * settles equality with a single extra call at the end. If Compare defines
+ * is_transparent, lookups accept any type it can compare with Key.
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          template <typename> class Storage = s21::HeapStorage,
+          typename Balance = s21::RedBlackBalance>
 class BinaryTree {
  protected:
-  struct Node {
+  enum Color { kRed, kBlack };
+
+  struct KeyValueData {
     const Key key_;
     T value_;
+
+    KeyValueData(const Key &key, const T &value) : key_{key}, value_{value} {}
+    KeyValueData(const Key &key, T &&value)
+        : key_{key}, value_{std::move(value)} {}
+    // Builds the mapped value in place from args
+    template <typename... Args>
+    KeyValueData(std::piecewise_construct_t, const Key &key, Args &&...args)
+        : key_{key}, value_(std::forward<Args>(args)...) {}
+  };
+
+  struct KeyData {
+    const Key key_;
+
+    explicit KeyData(const Key &key) : key_{key} {}
+  };
+
+  // What a node carries besides its links: the key and the mapped value,
+  // or only the key when T is void (set)
+  using NodeData =
+      std::conditional_t<std::is_void_v<T>, KeyData, KeyValueData>;
+
+  struct Node : NodeData {
     struct Node *parent_;
     struct Node *left_;
     struct Node *right_;
+    // Number of nodes in the subtree rooted here, shifted left by one; the
+    // freed lowest bit holds the colour so it costs no extra word
+    size_t count_color_;
 
-    Node(Key key, T value) : key_{key}, value_{value} {
+    template <typename... Args>
+    explicit Node(Args &&...args) : NodeData(std::forward<Args>(args)...) {
       parent_ = nullptr;
       left_ = nullptr;
       right_ = nullptr;
+      count_color_ = (size_t{1} << 1) | kRed;
+    }
+
+    Color color() const { return static_cast<Color>(count_color_ & 1); }
+    void set_color(Color color) {
+      count_color_ = (count_color_ & ~size_t{1}) | color;
+    }
+    size_t count() const { return count_color_ >> 1; }
+    void set_count(size_t count) {
+      count_color_ = (count << 1) | (count_color_ & 1);
+    }
+    void add_count(std::ptrdiff_t delta) {
+      count_color_ += static_cast<size_t>(delta) << 1;
     }
   };  // end struct Node
 
   using size_type = size_t;
+  using NodeStorage = Storage<Node>;
+
+  // Sentinel of the tree, the counterpart of the fake node of s21::list: an
+  // iterator at end() refers to it, so --end() lands on the largest key. It
+  // caches both ends of the tree to make Begin() and --End() O(1).
+  struct Header {
+    Node *leftmost_ = nullptr;
+    Node *rightmost_ = nullptr;
+  };
+
   Node *root_;
-  size_type counter_;
+  Header header_;
+  NodeStorage storage_;
+  Compare compare_;
 
-  BinaryTree() {
+  explicit BinaryTree(const Compare &compare = Compare())
+      : compare_(compare) {
     root_ = nullptr;
-    counter_ = 0;
   }
 
-  ~BinaryTree() {
-    DestroyTree(root_);
-    root_ = nullptr;
-  }
+  ~BinaryTree() { Clear(); }
 
  public:
+  // What iterators point to: the key, and the mapped value unless T is void
+  using Entry = NodeData;
+
   class const_iterator {
    private:
     Node *current_ = nullptr;
+    const Header *header_ = nullptr;  // the sentinel of the owning tree
+    friend class BinaryTree;
 
    public:
-    const_iterator(Node *cur_node) : current_(cur_node) {}
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Node *;
+    using reference = const Key &;
+
+    const_iterator(Node *cur_node, const Header *header = nullptr)
+        : current_(cur_node), header_(header) {}
     const Key &operator*() const { return current_->key_; }
     const Node *operator->() const { return current_; }
 
@@ -70,7 +152,9 @@ class BinaryTree {
 
     // Префиксный декремент
     const_iterator &operator--() {
-      if (current_->left_) {
+      if (current_ == nullptr) {
+        current_ = header_->rightmost_;
+      } else if (current_->left_) {
         current_ = current_->left_;
         while (current_->right_) current_ = current_->right_;
       } else {
@@ -101,23 +185,194 @@ class BinaryTree {
     }
   };  // end class const_iterator
 
-  const_iterator Begin() const {
-    Node *my_tree = root_;
-    while (my_tree && my_tree->left_) my_tree = my_tree->left_;
-    return const_iterator(my_tree);
-  }
-  const_iterator End() const { return const_iterator(nullptr); }
+  /**
+   * Owns a node that was extracted from a tree. The node keeps its key and
+   * value and can be linked into another tree of the same type without any
+   * allocation or copying (only a node moving between two different pools
+   * is recreated). An empty handle owns nothing.
+   */
+  class NodeHandle {
+   private:
+    Node *node_ = nullptr;
+    NodeStorage *storage_ = nullptr;  // the storage node_ came from
+    friend class BinaryTree;
+
+    NodeHandle(Node *node, NodeStorage *storage)
+        : node_(node), storage_(storage) {}
+
+    void Reset() {
+      if (node_ == nullptr) return;
+      if constexpr (NodeStorage::kSharesNodes) {
+        NodeStorage::Destroy(node_);
+      } else {
+        storage_->Destroy(node_);
+      }
+      node_ = nullptr;
+    }
+
+   public:
+    NodeHandle() = default;
+    NodeHandle(const NodeHandle &) = delete;
+    NodeHandle(NodeHandle &&other) noexcept
+        : node_(other.node_), storage_(other.storage_) {
+      other.node_ = nullptr;
+    }
+    NodeHandle &operator=(const NodeHandle &) = delete;
+    NodeHandle &operator=(NodeHandle &&other) noexcept {
+      if (this != &other) {
+        Reset();
+        node_ = other.node_;
+        storage_ = other.storage_;
+        other.node_ = nullptr;
+      }
+      return *this;
+    }
+    // With PoolStorage the handle must not outlive the tree it came from
+    ~NodeHandle() { Reset(); }
+
+    bool empty() const noexcept { return node_ == nullptr; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+    const Key &key() const { return node_->key_; }
+    template <typename U = T>
+    U &mapped() const {
+      return node_->value_;
+    }
+  };  // end class NodeHandle
+
+  struct InsertReturn {
+    const_iterator position;
+    bool inserted;
+    NodeHandle node;
+  };
+
+  /**
+   * A pair of iterators that can be used in range-based for. It owns
+   * nothing and is invalidated together with the iterators it holds.
+   */
+  class RangeView {
+   private:
+    const_iterator first_;
+    const_iterator last_;
+
+   public:
+    RangeView(const_iterator first, const_iterator last)
+        : first_(first), last_(last) {}
+    const_iterator begin() const { return first_; }
+    const_iterator end() const { return last_; }
+    bool empty() const { return first_ == last_; }
+  };  // end class RangeView
+
+  /**
+   * Cursor for lookups that land near each other, like sorted probes. It
+   * keeps the node found last and starts the next search there: it climbs
+   * only until the subtree in hand must hold the key, then descends. A key
+   * d positions away then costs about O(log d) instead of O(log n); a
+   * monotone sweep is amortized O(1 + log(gap)) per key. Erasing the node
+   * a finger rests on invalidates the finger, as it would an iterator.
+   */
+  class Finger {
+   private:
+    const BinaryTree *tree_;
+    Node *node_ = nullptr;
+
+   public:
+    explicit Finger(const BinaryTree &tree) : tree_(&tree) {}
+
+    template <typename K>
+    const_iterator lower_bound(const K &key) {
+      Node *bound = tree_->FingerLowerBound(node_, key);
+      node_ = bound ? bound : tree_->header_.rightmost_;
+      return tree_->MakeIterator(bound);
+    }
+    template <typename K>
+    const_iterator find(const K &key) {
+      const_iterator it = lower_bound(key);
+      return tree_->HoldsKey(it.current_, key) ? it : tree_->End();
+    }
+    template <typename K>
+    bool contains(const K &key) {
+      return find(key) != tree_->End();
+    }
+  };  // end class Finger
+
+  const_iterator Begin() const { return MakeIterator(header_.leftmost_); }
+  const_iterator End() const { return MakeIterator(nullptr); }
 
  protected:
+  // Frees the subtree without recursion: descends to a leaf, frees it,
+  // cuts it off its parent and continues from there
   void DestroyTree(Node *my_tree) {
-    if (my_tree != nullptr) {
-      DestroyTree(my_tree->left_);
-      DestroyTree(my_tree->right_);
-      delete my_tree;
-      my_tree = nullptr;
+    if (my_tree == nullptr) return;
+    Node *stop = my_tree->parent_;
+    Node *current = my_tree;
+    while (current != stop) {
+      if (current->left_) {
+        current = current->left_;
+      } else if (current->right_) {
+        current = current->right_;
+      } else {
+        Node *parent = current->parent_;
+        if (parent && parent != stop) {
+          (parent->left_ == current ? parent->left_ : parent->right_) = nullptr;
+        }
+        storage_.Destroy(current);
+        current = parent;
+      }
     }
   }
 
+  // Frees every node. A pool of trivially destructible nodes is released
+  // chunk by chunk without visiting the nodes at all.
+  void Clear() {
+    if (!NodeStorage::kBulkRelease || !std::is_trivially_destructible_v<Node>) {
+      DestroyTree(root_);
+    }
+    storage_.Release();
+    root_ = nullptr;
+    header_ = Header();
+  }
+
+  // Takes over the nodes of other, which is left empty
+  void MoveFrom(BinaryTree &other) {
+    Clear();
+    std::swap(root_, other.root_);
+    std::swap(header_, other.header_);
+    storage_.swap(other.storage_);
+    compare_ = other.compare_;
+  }
+
+  // Replaces the contents with copies of the nodes of other
+  void CopyFrom(const BinaryTree &other) {
+    Clear();
+    compare_ = other.compare_;
+    root_ = CopyTree(other.root_, nullptr);
+    ResetBounds();
+  }
+
+  // Recomputes the cached ends after the tree was relinked wholesale
+  void ResetBounds() {
+    header_.leftmost_ = root_ ? Minimum(root_) : nullptr;
+    header_.rightmost_ = root_ ? Maximum(root_) : nullptr;
+  }
+
+  const_iterator MakeIterator(Node *node) const {
+    return const_iterator(node, &header_);
+  }
+
+  template <typename... Args>
+  Node *CreateNode(Args &&...args) {
+    return storage_.Create(std::forward<Args>(args)...);
+  }
+
+  // Makes a node detached from the tree owning from usable here: nodes are
+  // taken over as they are unless they live in somebody else's pool
+  Node *AdoptNode(Node *node, NodeStorage &from) {
+    if (NodeStorage::kSharesNodes || &from == &storage_) return node;
+    Node *copy = CreateNode(std::move(static_cast<NodeData &>(*node)));
+    from.Destroy(node);
+    return copy;
+  }
+
   bool TreeEmpty() {
     bool result = true;
     if (root_ != nullptr) {
@@ -126,279 +381,1219 @@ class BinaryTree {
     return result;
   }
 
-  void CountNodes(Node *my_tree) {
-    if (my_tree) {
-      counter_++;
-      CountNodes(my_tree->left_);
-      CountNodes(my_tree->right_);
+  static size_type Count(const Node *node) {
+    return node ? node->count() : 0;
+  }
+
+  size_type Size() const { return Count(root_); }
+
+  // Walks from node to the root adding delta to every subtree count
+  static void UpdateCounts(Node *node, std::ptrdiff_t delta) {
+    for (; node != nullptr; node = node->parent_) node->add_count(delta);
+  }
+
+  // Returns the node holding the k-th smallest key (0-based) or End()
+  const_iterator Select(size_type k) const {
+    Node *current = root_;
+    while (current != nullptr) {
+      size_type left = Count(current->left_);
+      if (k < left) {
+        current = current->left_;
+      } else if (k > left) {
+        k -= left + 1;
+        current = current->right_;
+      } else {
+        break;
+      }
     }
+    return MakeIterator(current);
   }
 
-  std::pair<const_iterator, bool> AddNode(const Key &key, const T &value) {
-    if (root_ == nullptr) {
-      root_ = new Node(key, value);
-      return {root_, true};
+  // Returns the number of keys strictly less than key
+  template <typename K>
+  size_type Rank(const K &key) const {
+    size_type rank = 0;
+    Node *current = root_;
+    while (current != nullptr) {
+      if (compare_(current->key_, key)) {
+        rank += Count(current->left_) + 1;
+        current = current->right_;
+      } else {
+        current = current->left_;
+      }
     }
+    return rank;
+  }
+
+  // Returns the number of keys not greater than key
+  template <typename K>
+  size_type UpperRank(const K &key) const {
+    size_type rank = 0;
     Node *current = root_;
-    Node *parent = nullptr;
     while (current != nullptr) {
-      parent = current;
-      if (key < current->key_) {
+      if (compare_(key, current->key_)) {
         current = current->left_;
-      } else if (key > current->key_) {
+      } else {
+        rank += Count(current->left_) + 1;
+        current = current->right_;
+      }
+    }
+    return rank;
+  }
+
+  // Number of keys equivalent to key in O(log n), however many there are
+  template <typename K>
+  size_type CountEqual(const K &key) const {
+    return UpperRank(key) - Rank(key);
+  }
+
+  // First node of the subtree whose key is not less than key, or nullptr
+  template <typename K>
+  Node *LowerBoundNode(Node *current, const K &key) const {
+    Node *bound = nullptr;
+    while (current != nullptr) {
+      if (compare_(current->key_, key)) {
         current = current->right_;
       } else {
-        return {current, false};
+        bound = current;
+        current = current->left_;
       }
     }
-    Node *new_node = new Node(key, value);
-    new_node->parent_ = parent;
-    if (key < parent->key_) {
-      parent->left_ = new_node;
+    return bound;
+  }
+
+  // The lower bound holds key unless key is less than it
+  template <typename K>
+  bool HoldsKey(const Node *node, const K &key) const {
+    return node != nullptr && !compare_(key, node->key_);
+  }
+
+  template <typename K>
+  const_iterator LowerBound(const K &key) const {
+    return MakeIterator(LowerBoundNode(root_, key));
+  }
+
+  // First node whose key is greater than key, or End()
+  template <typename K>
+  const_iterator UpperBound(const K &key) const {
+    Node *bound = nullptr;
+    Node *current = root_;
+    while (current != nullptr) {
+      if (compare_(key, current->key_)) {
+        bound = current;
+        current = current->left_;
+      } else {
+        current = current->right_;
+      }
+    }
+    return MakeIterator(bound);
+  }
+
+  // Keys are unique, so the upper end is at most one step past the lower
+  // one and a single descent is enough
+  template <typename K>
+  std::pair<const_iterator, const_iterator> EqualRange(const K &key) const {
+    Node *node = LowerBoundNode(root_, key);
+    const_iterator first = MakeIterator(node);
+    const_iterator last = first;
+    if (HoldsKey(node, key)) ++last;
+    return {first, last};
+  }
+
+  // With duplicates allowed both ends need their own descent
+  template <typename K>
+  std::pair<const_iterator, const_iterator> MultiEqualRange(
+      const K &key) const {
+    return {LowerBound(key), UpperBound(key)};
+  }
+
+  // Nodes with keys in [low, high)
+  RangeView Range(const Key &low, const Key &high) const {
+    if (!compare_(low, high)) return RangeView(End(), End());
+    return RangeView(LowerBound(low), LowerBound(high));
+  }
+
+  /**
+   * Looks up every key of [first, last) and calls visit(index, node) for
+   * each, node being nullptr for a missing key. Up to kLookupLanes descents
+   * run interleaved: one round moves every unfinished search one level down
+   * and prefetches the child it lands on, which is then loaded while the
+   * other lanes take their step. The cache misses of a single descent form
+   * a dependent chain; here those of all lanes overlap.
+   */
+  template <typename ForwardIt, typename Visit>
+  void FindBatch(ForwardIt first, ForwardIt last, Visit visit) const {
+    constexpr size_type kLookupLanes = 16;
+    ForwardIt keys[kLookupLanes];
+    Node *current[kLookupLanes];
+    Node *bound[kLookupLanes];
+    size_type index = 0;
+    while (first != last) {
+      size_type lanes = 0;
+      for (; lanes < kLookupLanes && first != last; ++lanes, ++first) {
+        keys[lanes] = first;
+        current[lanes] = root_;
+        bound[lanes] = nullptr;
+      }
+      for (bool active = root_ != nullptr; active;) {
+        active = false;
+        for (size_type lane = 0; lane < lanes; ++lane) {
+          Node *node = current[lane];
+          if (node == nullptr) continue;
+          if (compare_(node->key_, *keys[lane])) {
+            node = node->right_;
+          } else {
+            bound[lane] = node;
+            node = node->left_;
+          }
+          current[lane] = node;
+          if (node != nullptr) {
+            Prefetch(node);
+            active = true;
+          }
+        }
+      }
+      for (size_type lane = 0; lane < lanes; ++lane) {
+        visit(index++,
+              HoldsKey(bound[lane], *keys[lane]) ? bound[lane] : nullptr);
+      }
+    }
+  }
+
+  static void Prefetch(const Node *node) {
+#if defined(__GNUC__)
+    __builtin_prefetch(node);
+#else
+    (void)node;
+#endif
+  }
+
+  /**
+   * Lower bound of key, searched from finger (from the root if it is
+   * nullptr). Going right the climb continues while the parent is smaller
+   * than key or we come from its right; it stops under a parent not less
+   * than key, which is the answer if the subtree has none. Going left it
+   * continues until we come from the right of a parent smaller than key,
+   * so the subtree holds the answer.
+   */
+  template <typename K>
+  Node *FingerLowerBound(Node *finger, const K &key) const {
+    if (finger == nullptr) return LowerBoundNode(root_, key);
+    Node *node = finger;
+    if (compare_(node->key_, key)) {
+      while (node->parent_ && (node == node->parent_->right_ ||
+                               compare_(node->parent_->key_, key))) {
+        node = node->parent_;
+      }
+      Node *bound = LowerBoundNode(node, key);
+      return bound ? bound : node->parent_;
+    }
+    if (!compare_(key, node->key_)) return node;
+    while (node->parent_ && (node == node->parent_->left_ ||
+                             !compare_(node->parent_->key_, key))) {
+      node = node->parent_;
+    }
+    return LowerBoundNode(node, key);
+  }
+
+  // Descends to key: returns the node holding it, or nullptr and the parent
+  // under which a node with this key has to be attached. The walk always
+  // goes down to a leaf, remembering the lower bound for the final check.
+  Node *FindSlot(const Key &key, Node **parent) const {
+    Node *current = root_;
+    Node *bound = nullptr;
+    *parent = nullptr;
+    while (current != nullptr) {
+      *parent = current;
+      if (compare_(current->key_, key)) {
+        current = current->right_;
+      } else {
+        bound = current;
+        current = current->left_;
+      }
+    }
+    return HoldsKey(bound, key) ? bound : nullptr;
+  }
+
+  // Parent for a new node in a tree that allows duplicates. The descent
+  // passes every key not greater than key on the left, so a new node goes
+  // after its equals and they keep their insertion order.
+  Node *FindMultiSlot(const Key &key) const {
+    Node *parent = nullptr;
+    Node *current = root_;
+    while (current != nullptr) {
+      parent = current;
+      current = compare_(key, current->key_) ? current->left_ : current->right_;
+    }
+    return parent;
+  }
+
+  // Links a detached node as a leaf under parent and rebalances
+  void AttachNode(Node *node, Node *parent) {
+    node->parent_ = parent;
+    node->left_ = nullptr;
+    node->right_ = nullptr;
+    node->set_color(kRed);
+    node->set_count(1);
+    if (parent == nullptr) {
+      root_ = node;
+      header_.leftmost_ = node;
+      header_.rightmost_ = node;
+    } else if (compare_(node->key_, parent->key_)) {
+      parent->left_ = node;
+      if (parent == header_.leftmost_) header_.leftmost_ = node;
     } else {
-      parent->right_ = new_node;
-    }
-    return {new_node, true};
-  }
-
-  // void Erase(const_iterator pos) {
-  //   if (pos == nullptr) {
-  //     return;
-  //   }
-  //   std::cout << "Delete: " << pos->key_ << std::endl;
-  //   Node *parent_erase = pos->parent_;
-  //   Node *new_root = nullptr;
-  //   if (pos->left_) {
-  //     std::cout << "Delete: left" << std::endl;
-  //     new_root = pos->left_;
-  //     if (pos->right_) {
-  //       Node *current = pos->left_;
-  //       Node *parent = nullptr;
-  //       while (current) {
-  //         parent = current;
-  //         current = current->right_;
-  //       }
-  //       parent->right_ = pos->right_;
-  //     }
-  //   } else if (pos->right_) {
-  //     std::cout << "Delete: right" << std::endl;
-  //     new_root = pos->right_;
-  //   } else if (parent_erase) {
-  //     if (pos->key_ < parent_erase->key_) {
-  //       parent_erase->left_ = EraseNode(parent_erase->left_);
-  //     } else {
-  //       std::cout << "Delete: parent" << std::endl;
-  //       parent_erase->right_ = EraseNode(parent_erase->right_);
-  //     }
-  //   } else {
-  //     root_ = EraseNode(root_);
-  //   }
-  //   Node *node_erase = nullptr;
-  //   if (new_root && parent_erase) {
-  //     node_erase = new_root->parent_;
-  //     new_root->parent_ = parent_erase;
-  //     if (new_root->key_ < parent_erase->key_) {
-  //       parent_erase->left_ = new_root;
-  //     } else {
-  //       parent_erase->right_ = new_root;
-  //     }
-  //   } else if (new_root && !parent_erase) {
-  //     node_erase = root_;
-  //     root_ = new_root;
-  //   }
-  //   EraseNode(node_erase);
-  // }
-
-  void AddSubtree(Node *subroot) {
-    if (!subroot) {
-      return;
+      parent->right_ = node;
+      if (parent == header_.rightmost_) header_.rightmost_ = node;
+    }
+    UpdateCounts(parent, 1);
+    if constexpr (Balance::kSelfAdjusting) {
+      Splay(node);
+    } else {
+      InsertFixup(node);
+    }
+  }
+
+  // Splay policy: rotates node up to the root, two levels per step
+  void Splay(Node *node) {
+    while (node->parent_ != nullptr) {
+      Node *parent = node->parent_;
+      Node *grand = parent->parent_;
+      bool left = node == parent->left_;
+      if (grand == nullptr) {
+        left ? RotateRight(parent) : RotateLeft(parent);
+      } else if (left == (parent == grand->left_)) {
+        // zig-zig: the grandparent goes first
+        left ? RotateRight(grand) : RotateLeft(grand);
+        left ? RotateRight(parent) : RotateLeft(parent);
+      } else {
+        // zig-zag
+        left ? RotateRight(parent) : RotateLeft(parent);
+        left ? RotateLeft(grand) : RotateRight(grand);
+      }
+    }
+  }
+
+  // Splay policy: a found node moves to the root
+  void Access(Node *node) {
+    if constexpr (Balance::kSelfAdjusting) {
+      if (node != nullptr) Splay(node);
+    }
+  }
+
+  // value is the mapped value for map and absent for set
+  template <typename... Value>
+  std::pair<const_iterator, bool> AddNode(const Key &key, Value &&...value) {
+    Node *parent = nullptr;
+    Node *existing = FindSlot(key, &parent);
+    if (existing) {
+      Access(existing);
+      return {MakeIterator(existing), false};
+    }
+    Node *new_node = CreateNode(key, std::forward<Value>(value)...);
+    AttachNode(new_node, parent);
+    return {MakeIterator(new_node), true};
+  }
+
+  // Constructs the mapped value from args in a new node unless key is
+  // already present. Either way the tree is descended only once.
+  template <typename... Args>
+  std::pair<const_iterator, bool> TryEmplace(const Key &key, Args &&...args) {
+    Node *parent = nullptr;
+    Node *existing = FindSlot(key, &parent);
+    return EmplaceAt(existing, parent, key, std::forward<Args>(args)...);
+  }
+
+  // Same as TryEmplace, but skips the descent when key belongs right
+  // before hint (or right after the node preceding it)
+  template <typename... Args>
+  std::pair<const_iterator, bool> TryEmplaceHint(const_iterator hint,
+                                                 const Key &key,
+                                                 Args &&...args) {
+    Node *parent = nullptr;
+    Node *existing = HintSlot(hint, key, &parent);
+    return EmplaceAt(existing, parent, key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<const_iterator, bool> EmplaceAt(Node *existing, Node *parent,
+                                            const Key &key, Args &&...args) {
+    if (existing) {
+      Access(existing);
+      return {MakeIterator(existing), false};
     }
-    AddNode(subroot->key_, subroot->value_);
-    AddSubtree(subroot->left_);
-    AddSubtree(subroot->right_);
+    Node *node =
+        CreateNode(std::piecewise_construct, key, std::forward<Args>(args)...);
+    AttachNode(node, parent);
+    return {MakeIterator(node), true};
   }
 
   /**
-   * 1) Determine which child (may be nullptr) becomes the "main" child
-   *
-   * 2) If the node had two children, the "other" child is whichever is
-   * not'main_child'
-   *
-   * 3) If current node is on the left side of its parent, each
-   * of his children will also go to the left and vice versa
-   *
-   * 4) If we are erasing the root, make main_child the new root
-   *
-   * 5) If there is another child, traverse its descendants and add each one
-   *
-   * 6) If no children exist and this node is not root, simply remove it from
-   * parent
-   *
-   * 7) If erasing a leaf that is root, tree becomes empty
-   *
-   * 8) Finally, erase the current node from memory
+   * Like FindSlot, but first checks whether key fits between hint and its
+   * predecessor. Of these two neighbours one always has a free child on the
+   * side facing the other, so a correct hint gives the slot in O(1); a
+   * wrong one costs the usual descent.
    */
-  void Erase(const_iterator pos) {
-    if (pos == nullptr) return;
-
-    Node *parent_of_erased = pos->parent_;
-    Node *left_child = pos->left_;
-    Node *right_child = pos->right_;
-
-    Node *main_child = (left_child ? left_child : right_child);
-    Node *other_child =
-        (left_child && right_child)
-            ? (main_child == left_child ? right_child : left_child)
-            : nullptr;
-
-    if (main_child) {
-      main_child->parent_ = EraseNode(main_child->parent_);
-      if (parent_of_erased) {
-        if (pos->key_ < parent_of_erased->key_) {
-          parent_of_erased->left_ = main_child;
+  Node *HintSlot(const_iterator hint, const Key &key, Node **parent) const {
+    Node *next = hint.current_;
+    Node *prev = nullptr;
+    if (next == nullptr) {
+      prev = header_.rightmost_;
+    } else if (next != header_.leftmost_) {
+      prev = (--MakeIterator(next)).current_;
+    }
+    bool before_next = next == nullptr || compare_(key, next->key_);
+    bool after_prev = prev == nullptr || compare_(prev->key_, key);
+    if (root_ == nullptr || !before_next || !after_prev) {
+      return FindSlot(key, parent);
+    }
+    if (next && next->left_ == nullptr) {
+      *parent = next;
+    } else {
+      *parent = prev;
+    }
+    return nullptr;
+  }
+
+  // Inserts unconditionally, after any nodes with an equal key
+  template <typename... Value>
+  const_iterator AddMultiNode(const Key &key, Value &&...value) {
+    Node *node = CreateNode(key, std::forward<Value>(value)...);
+    AttachNode(node, FindMultiSlot(key));
+    return MakeIterator(node);
+  }
+
+  const_iterator AddMultiNode(NodeHandle &&handle) {
+    if (handle.empty()) return End();
+    Node *node = AdoptNode(handle.node_, *handle.storage_);
+    handle.node_ = nullptr;
+    AttachNode(node, FindMultiSlot(node->key_));
+    return MakeIterator(node);
+  }
+
+  // Links the node owned by the handle; a duplicate key leaves it in place
+  InsertReturn AddNode(NodeHandle &&handle) {
+    if (handle.empty()) {
+      return {End(), false, NodeHandle()};
+    }
+    Node *parent = nullptr;
+    Node *existing = FindSlot(handle.node_->key_, &parent);
+    if (existing) {
+      return {MakeIterator(existing), false, std::move(handle)};
+    }
+    Node *node = AdoptNode(handle.node_, *handle.storage_);
+    handle.node_ = nullptr;
+    AttachNode(node, parent);
+    return {MakeIterator(node), true, NodeHandle()};
+  }
+
+  static bool IsRed(const Node *node) {
+    return node != nullptr && node->color() == kRed;
+  }
+  static bool IsBlack(const Node *node) { return !IsRed(node); }
+
+  static Node *Minimum(Node *node) {
+    while (node->left_) node = node->left_;
+    return node;
+  }
+
+  static Node *Maximum(Node *node) {
+    while (node->right_) node = node->right_;
+    return node;
+  }
+
+  // Puts new_child in place of old_child under parent (or at the root)
+  void ReplaceChild(Node *parent, Node *old_child, Node *new_child) {
+    if (parent == nullptr) {
+      root_ = new_child;
+    } else if (parent->left_ == old_child) {
+      parent->left_ = new_child;
+    } else {
+      parent->right_ = new_child;
+    }
+    if (new_child) new_child->parent_ = parent;
+  }
+
+  void RotateLeft(Node *node) {
+    Node *pivot = node->right_;
+    node->right_ = pivot->left_;
+    if (pivot->left_) pivot->left_->parent_ = node;
+    ReplaceChild(node->parent_, node, pivot);
+    pivot->left_ = node;
+    node->parent_ = pivot;
+    pivot->set_count(node->count());
+    node->set_count(Count(node->left_) + Count(node->right_) + 1);
+  }
+
+  void RotateRight(Node *node) {
+    Node *pivot = node->left_;
+    node->left_ = pivot->right_;
+    if (pivot->right_) pivot->right_->parent_ = node;
+    ReplaceChild(node->parent_, node, pivot);
+    pivot->right_ = node;
+    node->parent_ = pivot;
+    pivot->set_count(node->count());
+    node->set_count(Count(node->left_) + Count(node->right_) + 1);
+  }
+
+  /**
+   * Restores the red-black properties after a red leaf was linked in.
+   * While the parent is red: a red uncle is fixed by recolouring and moving
+   * the violation two levels up, a black uncle by one or two rotations.
+   * Returns true if the root ended up red and was recoloured, which makes
+   * the black height of the whole tree grow by one.
+   */
+  bool InsertFixup(Node *node) {
+    while (IsRed(node->parent_)) {
+      Node *parent = node->parent_;
+      Node *grand = parent->parent_;
+      if (parent == grand->left_) {
+        Node *uncle = grand->right_;
+        if (IsRed(uncle)) {
+          parent->set_color(kBlack);
+          uncle->set_color(kBlack);
+          grand->set_color(kRed);
+          node = grand;
         } else {
-          parent_of_erased->right_ = main_child;
+          if (node == parent->right_) {
+            RotateLeft(parent);
+            std::swap(node, parent);
+          }
+          parent->set_color(kBlack);
+          grand->set_color(kRed);
+          RotateRight(grand);
         }
-        main_child->parent_ = parent_of_erased;
       } else {
-        root_ = main_child;
+        Node *uncle = grand->left_;
+        if (IsRed(uncle)) {
+          parent->set_color(kBlack);
+          uncle->set_color(kBlack);
+          grand->set_color(kRed);
+          node = grand;
+        } else {
+          if (node == parent->left_) {
+            RotateRight(parent);
+            std::swap(node, parent);
+          }
+          parent->set_color(kBlack);
+          grand->set_color(kRed);
+          RotateLeft(grand);
+        }
       }
+    }
+    bool grew = IsRed(root_);
+    root_->set_color(kBlack);
+    return grew;
+  }
 
-      if (other_child) {
-        AddSubtree(other_child);
+  /**
+   * Restores the black height after a black node was unlinked. node is the
+   * child that took its place (may be nullptr, hence the explicit parent).
+   */
+  void EraseFixup(Node *node, Node *parent) {
+    while (node != root_ && IsBlack(node)) {
+      if (node == parent->left_) {
+        Node *sibling = parent->right_;
+        if (IsRed(sibling)) {
+          sibling->set_color(kBlack);
+          parent->set_color(kRed);
+          RotateLeft(parent);
+          sibling = parent->right_;
+        }
+        if (IsBlack(sibling->left_) && IsBlack(sibling->right_)) {
+          sibling->set_color(kRed);
+          node = parent;
+          parent = node->parent_;
+        } else {
+          if (IsBlack(sibling->right_)) {
+            sibling->left_->set_color(kBlack);
+            sibling->set_color(kRed);
+            RotateRight(sibling);
+            sibling = parent->right_;
+          }
+          sibling->set_color(parent->color());
+          parent->set_color(kBlack);
+          sibling->right_->set_color(kBlack);
+          RotateLeft(parent);
+          node = root_;
+        }
+      } else {
+        Node *sibling = parent->left_;
+        if (IsRed(sibling)) {
+          sibling->set_color(kBlack);
+          parent->set_color(kRed);
+          RotateRight(parent);
+          sibling = parent->left_;
+        }
+        if (IsBlack(sibling->left_) && IsBlack(sibling->right_)) {
+          sibling->set_color(kRed);
+          node = parent;
+          parent = node->parent_;
+        } else {
+          if (IsBlack(sibling->left_)) {
+            sibling->right_->set_color(kBlack);
+            sibling->set_color(kRed);
+            RotateLeft(sibling);
+            sibling = parent->left_;
+          }
+          sibling->set_color(parent->color());
+          parent->set_color(kBlack);
+          sibling->left_->set_color(kBlack);
+          RotateRight(parent);
+          node = root_;
+        }
       }
+    }
+    if (node) node->set_color(kBlack);
+  }
+
+  /**
+   * 1) A node with at most one child is replaced by that child
+   *
+   * 2) A node with two children is replaced by its in-order successor, which
+   * is unlinked from its own place first (it never has a left child)
+   *
+   * 3) If the node that physically left the tree was black, the black height
+   * of that path shrank by one and EraseFixup repairs it
+   *
+   * 4) The node is detached, not freed: Erase deletes it, Extract hands it
+   * over to a NodeHandle
+   *
+   * Only pointers are relinked: no node is allocated or copied, so iterators
+   * to all other elements stay valid. The unlinked node is returned.
+   */
+  Node *Unlink(Node *target) {
+    // The smallest node has no left child, so its successor is either the
+    // minimum of its right subtree or its parent (and symmetrically)
+    if (target == header_.leftmost_) {
+      header_.leftmost_ = target->right_ ? Minimum(target->right_)
+                                         : target->parent_;
+    }
+    if (target == header_.rightmost_) {
+      header_.rightmost_ = target->left_ ? Maximum(target->left_)
+                                         : target->parent_;
+    }
+    Color removed_color = target->color();
+    Node *child = nullptr;
+    Node *child_parent = nullptr;
+    if (target->left_ == nullptr || target->right_ == nullptr) {
+      child = target->left_ ? target->left_ : target->right_;
+      child_parent = target->parent_;
+      UpdateCounts(target->parent_, -1);
+      ReplaceChild(target->parent_, target, child);
     } else {
-      if (parent_of_erased) {
-        if (pos->key_ < parent_of_erased->key_) {
-          parent_of_erased->left_ = EraseNode(parent_of_erased->left_);
-        } else {
-          parent_of_erased->right_ = EraseNode(parent_of_erased->right_);
+      Node *successor = Minimum(target->right_);
+      UpdateCounts(successor->parent_, -1);
+      removed_color = successor->color();
+      child = successor->right_;
+      if (successor->parent_ == target) {
+        child_parent = successor;
+      } else {
+        child_parent = successor->parent_;
+        ReplaceChild(successor->parent_, successor, child);
+        successor->right_ = target->right_;
+        successor->right_->parent_ = successor;
+      }
+      ReplaceChild(target->parent_, target, successor);
+      successor->left_ = target->left_;
+      successor->left_->parent_ = successor;
+      successor->set_color(target->color());
+      successor->set_count(target->count());
+    }
+    if constexpr (!Balance::kSelfAdjusting) {
+      if (removed_color == kBlack) EraseFixup(child, child_parent);
+    }
+    target->parent_ = nullptr;
+    target->left_ = nullptr;
+    target->right_ = nullptr;
+    return target;
+  }
+
+  // Unlinks and frees the node at pos, returns the iterator following it
+  const_iterator Erase(const_iterator pos) {
+    if (pos.current_ == nullptr) return End();
+    const_iterator next = pos;
+    ++next;
+    EraseNode(Unlink(pos.current_));
+    return next;
+  }
+
+  // Unlinks and frees [first, last). Only the k nodes of the range are
+  // visited: freeing them costs about as much as unlinking them, so neither
+  // a split and join nor an O(n) rebuild pays off here.
+  const_iterator EraseRange(const_iterator first, const_iterator last) {
+    while (first != last) first = Erase(first);
+    return last;
+  }
+
+  // Frees every node whose entry satisfies pred, returns how many
+  template <typename Pred>
+  size_type EraseIf(Pred pred) {
+    return Compact([&pred](const Node *node) {
+      return static_cast<bool>(pred(static_cast<const Entry &>(*node)));
+    });
+  }
+
+  // Frees the nodes for which doomed(node) holds and rebuilds the survivors
+  // into a balanced tree, all in O(n) with no rebalancing. The in-order walk
+  // keeps the unvisited ancestors on a stack, so a node is done with once
+  // visited and a doomed one is freed while still in cache. If doomed
+  // throws, the nodes not yet visited are all kept.
+  template <typename Doomed>
+  size_type Compact(Doomed doomed) {
+    size_type total = Size();
+    std::vector<Node *> kept;
+    kept.reserve(total);
+    std::vector<Node *> ancestors;
+    std::exception_ptr error;
+    Node *node = root_;
+    while (node != nullptr || !ancestors.empty()) {
+      for (; node != nullptr; node = node->left_) ancestors.push_back(node);
+      Node *current = ancestors.back();
+      ancestors.pop_back();
+      node = current->right_;
+      bool drop = false;
+      if (!error) {
+        try {
+          drop = doomed(current);
+        } catch (...) {
+          error = std::current_exception();
         }
+      }
+      if (drop) {
+        storage_.Destroy(current);
       } else {
-        root_ = EraseNode(root_);
+        kept.push_back(current);
       }
     }
+    BuildFromSorted(kept);
+    if (error) std::rethrow_exception(error);
+    return total - kept.size();
+  }
+
+  NodeHandle Extract(const_iterator pos) {
+    if (pos.current_ == nullptr) return NodeHandle();
+    return NodeHandle(Unlink(pos.current_), &storage_);
   }
 
   Node *EraseNode(Node *current) {
     if (current) {
-      delete current;
+      storage_.Destroy(current);
     }
     return nullptr;
   }
 
-  const_iterator FindNode(Node *current, const Key &key) {
-    const_iterator result = const_iterator(root_);
-    if (key < current->key_) {
-      result = FindNode(current->left_, key);
-    } else if (key > current->key_) {
-      result = FindNode(current->right_, key);
+  template <typename K>
+  const_iterator FindNode(Node *current, const K &key) const {
+    Node *bound = LowerBoundNode(current, key);
+    if (!HoldsKey(bound, key)) return End();
+    return MakeIterator(bound);
+  }
+
+  // FindNode for a non-const container: under SplayBalance the found node
+  // is also moved to the root
+  template <typename K>
+  const_iterator AccessNode(Node *current, const K &key) {
+    Node *bound = LowerBoundNode(current, key);
+    if (!HoldsKey(bound, key)) return End();
+    Access(bound);
+    return MakeIterator(bound);
+  }
+
+  template <typename K>
+  bool Contains(Node *current, const K &key) const {
+    return FindNode(current, key) != End();
+  }
+
+  void Swap(BinaryTree &other) {
+    std::swap(root_, other.root_);
+    std::swap(header_, other.header_);
+    storage_.swap(other.storage_);
+    std::swap(compare_, other.compare_);
+  }
+
+  // Moves every node whose key is missing here from other into this tree.
+  // Nodes are relinked, never reallocated (except between two pools);
+  // duplicates stay in other.
+  void Merge(BinaryTree &other) {
+    if (this == &other) return;
+    Node *current = other.Begin().current_;
+    while (current != nullptr) {
+      Node *node = current;
+      current = (++const_iterator(current)).current_;
+      Node *parent = nullptr;
+      if (FindSlot(node->key_, &parent) == nullptr) {
+        AttachNode(AdoptNode(other.Unlink(node), other.storage_), parent);
+      }
+    }
+  }
+
+  // Takes every node of other, which is left empty, merge-walking both trees
+  // and relinking the result in O(n + m). A key present on both sides keeps
+  // our node if keep_common and loses both nodes otherwise; the duplicate
+  // from other is freed either way.
+  void CombineFrom(BinaryTree &other, bool keep_common) {
+    if (this == &other) {
+      if (!keep_common) Clear();
+      return;
+    }
+    auto in_order = [](const BinaryTree &tree) {
+      std::vector<Node *> nodes;
+      nodes.reserve(tree.Size());
+      for (Node *node = tree.header_.leftmost_; node != nullptr;
+           node = (++const_iterator(node)).current_) {
+        nodes.push_back(node);
+      }
+      return nodes;
+    };
+    std::vector<Node *> ours = in_order(*this);
+    std::vector<Node *> theirs = in_order(other);
+    other.root_ = nullptr;
+    other.header_ = Header();
+
+    std::vector<Node *> merged;
+    merged.reserve(ours.size() + theirs.size());
+    auto mine = ours.begin();
+    auto incoming = theirs.begin();
+    while (mine != ours.end() || incoming != theirs.end()) {
+      if (incoming == theirs.end() ||
+          (mine != ours.end() && compare_((*mine)->key_, (*incoming)->key_))) {
+        merged.push_back(*mine++);
+      } else if (mine == ours.end() ||
+                 compare_((*incoming)->key_, (*mine)->key_)) {
+        merged.push_back(AdoptNode(*incoming++, other.storage_));
+      } else {
+        other.storage_.Destroy(*incoming++);
+        if (keep_common) {
+          merged.push_back(*mine);
+        } else {
+          storage_.Destroy(*mine);
+        }
+        ++mine;
+      }
+    }
+    BuildFromSorted(merged);
+  }
+
+  // A red-black tree cut loose from any parent: its root, black or nullptr,
+  // and the number of black nodes on every path from it down to a leaf
+  struct Subtree {
+    Node *root;
+    size_type black_height;
+  };
+
+  static size_type BlackHeight(const Node *node) {
+    size_type height = 0;
+    for (; node != nullptr; node = node->left_) height += IsBlack(node);
+    return height;
+  }
+
+  // Makes child a tree of its own. height is its black height as a child;
+  // a red root is turned black, adding one to it.
+  static Subtree DetachChild(Node *child, size_type height) {
+    if (child == nullptr) return {nullptr, 0};
+    child->parent_ = nullptr;
+    if (IsRed(child)) {
+      child->set_color(kBlack);
+      ++height;
+    }
+    return {child, height};
+  }
+
+  /**
+   * Links left, middle and right, whose keys are in this order, into one
+   * tree in O(|difference of black heights| + 1). Equal heights just hang
+   * both trees under middle. Otherwise middle is linked red into the taller
+   * tree, along its inner spine, at the first black node as high (in black
+   * nodes) as the lower tree, taking that node and the lower tree as its
+   * children. This is a red leaf insertion in all but name, so InsertFixup
+   * repairs it. root_ is used as scratch while doing so.
+   */
+  Subtree Join(Subtree left, Node *middle, Subtree right) {
+    middle->parent_ = nullptr;
+    if (left.black_height == right.black_height) {
+      middle->left_ = left.root;
+      middle->right_ = right.root;
+      if (left.root) left.root->parent_ = middle;
+      if (right.root) right.root->parent_ = middle;
+      middle->set_color(kBlack);
+      middle->set_count(Count(left.root) + Count(right.root) + 1);
+      return {middle, left.black_height + 1};
+    }
+    bool left_taller = left.black_height > right.black_height;
+    Subtree tall = left_taller ? left : right;
+    Subtree low = left_taller ? right : left;
+    Node *parent = nullptr;
+    Node *spot = tall.root;
+    size_type height = tall.black_height;
+    while (!IsBlack(spot) || height != low.black_height) {
+      if (IsBlack(spot)) --height;
+      parent = spot;
+      spot = left_taller ? spot->right_ : spot->left_;
+    }
+    middle->left_ = left_taller ? spot : low.root;
+    middle->right_ = left_taller ? low.root : spot;
+    if (middle->left_) middle->left_->parent_ = middle;
+    if (middle->right_) middle->right_->parent_ = middle;
+    middle->parent_ = parent;
+    (left_taller ? parent->right_ : parent->left_) = middle;
+    middle->set_color(kRed);
+    middle->set_count(Count(spot) + Count(low.root) + 1);
+    UpdateCounts(parent, static_cast<std::ptrdiff_t>(Count(low.root) + 1));
+    root_ = tall.root;
+    bool grew = InsertFixup(middle);
+    return {root_, tall.black_height + (grew ? 1 : 0)};
+  }
+
+  // Splits a tree into the keys less than key and the rest. Every level
+  // joins the untouched half with the root and a piece of the result one
+  // level down; the joined trees grow in height, so the total is O(log n).
+  std::pair<Subtree, Subtree> Split(Subtree tree, const Key &key) {
+    if (tree.root == nullptr) return {tree, tree};
+    Node *node = tree.root;
+    Subtree left = DetachChild(node->left_, tree.black_height - 1);
+    Subtree right = DetachChild(node->right_, tree.black_height - 1);
+    if (compare_(node->key_, key)) {
+      auto [lower, upper] = Split(right, key);
+      return {Join(left, node, lower), upper};
+    }
+    auto [lower, upper] = Split(left, key);
+    return {lower, Join(upper, node, right)};
+  }
+
+  // Moves the keys not less than key into upper, which is cleared first.
+  // Nodes are relinked in O(log n); only between two pools are the moved
+  // ones recreated, in O(moved). A splay tree brings the lower bound of key
+  // to the root and cuts off its left subtree instead.
+  void SplitInto(const Key &key, BinaryTree &upper) {
+    upper.Clear();
+    upper.compare_ = compare_;
+    if (root_ == nullptr) return;
+    Node *higher = nullptr;
+    if constexpr (Balance::kSelfAdjusting) {
+      higher = LowerBoundNode(root_, key);
+      if (higher != nullptr) {
+        Splay(higher);
+        root_ = higher->left_;
+        if (root_) root_->parent_ = nullptr;
+        higher->left_ = nullptr;
+        higher->set_count(Count(higher->right_) + 1);
+      }
     } else {
-      result = const_iterator(current);
+      auto [lower, upper_part] = Split({root_, BlackHeight(root_)}, key);
+      root_ = lower.root;
+      higher = upper_part.root;
     }
-    return result;
+    ResetBounds();
+    if constexpr (NodeStorage::kSharesNodes) {
+      upper.root_ = higher;
+    } else {
+      upper.root_ = upper.CopyTree(higher, nullptr);
+      DestroyTree(higher);
+    }
+    upper.ResetBounds();
   }
 
-  bool Contains(Node *current, const Key &key) {
-    if (current == nullptr) {
-      return false;
+  // Appends all nodes of upper, whose keys must all be greater than ours,
+  // and leaves it empty. Our largest node becomes the middle of a Join, so
+  // it takes O(log n). Overlapping key ranges are merged instead.
+  void JoinFrom(BinaryTree &upper) {
+    if (this == &upper || upper.root_ == nullptr) return;
+    if (root_ != nullptr &&
+        !compare_(header_.rightmost_->key_, upper.header_.leftmost_->key_)) {
+      Merge(upper);
+      return;
+    }
+    Node *right = upper.root_;
+    if constexpr (!NodeStorage::kSharesNodes) {
+      right = CopyTree(upper.root_, nullptr);
+      upper.Clear();
     }
-    bool result = false;
-    if (key < current->key_) {
-      result = Contains(current->left_, key);
-    } else if (key > current->key_) {
-      result = Contains(current->right_, key);
+    upper.root_ = nullptr;
+    upper.header_ = Header();
+    if (root_ == nullptr) {
+      root_ = right;
+    } else if constexpr (Balance::kSelfAdjusting) {
+      // Our largest node, once at the root, has a free right child
+      Node *top = header_.rightmost_;
+      Splay(top);
+      top->right_ = right;
+      right->parent_ = top;
+      top->add_count(static_cast<std::ptrdiff_t>(Count(right)));
     } else {
-      result = true;
+      Node *middle = Unlink(header_.rightmost_);
+      root_ = Join({root_, BlackHeight(root_)}, middle,
+                   {right, BlackHeight(right)})
+                  .root;
     }
-    return result;
+    ResetBounds();
+  }
+
+  // Moves the nodes of [first, last) into out with two splits and a join
+  void ExtractRange(const_iterator first, const_iterator last,
+                    BinaryTree &out) {
+    out.Clear();
+    if (first == last) return;
+    const Key first_key = first.current_->key_;
+    BinaryTree tail(compare_);
+    if (last != End()) {
+      const Key last_key = last.current_->key_;
+      SplitInto(last_key, tail);
+    }
+    SplitInto(first_key, out);
+    JoinFrom(tail);
+  }
+
+  // Moves every node of other here, equal keys going after the ones already
+  // present. Other is emptied in order and the result is built in O(n + m)
+  // or, for a small other, linked node by node.
+  void MergeAll(BinaryTree &other) {
+    if (this == &other) return;
+    std::vector<Node *> batch;
+    batch.reserve(other.Size());
+    for (Node *node = other.header_.leftmost_; node != nullptr;
+         node = (++const_iterator(node)).current_) {
+      batch.push_back(node);
+    }
+    other.root_ = nullptr;
+    other.header_ = Header();
+    for (Node *&node : batch) node = AdoptNode(node, other.storage_);
+    InsertMultiBatch(batch);
+  }
+
+  /**
+   * Links nodes[first, last), sorted by key (duplicates allowed), into a
+   * perfectly balanced subtree in O(n). Midpoint splitting keeps all empty
+   * children at depth red_depth or red_depth + 1, so colouring the nodes on
+   * level red_depth red and the rest black gives equal black heights.
+   */
+  static Node *BuildBalanced(Node *const *nodes, size_type first,
+                             size_type last, Node *parent, size_type depth,
+                             size_type red_depth) {
+    if (first == last) return nullptr;
+    size_type middle = first + (last - first) / 2;
+    Node *node = nodes[middle];
+    node->parent_ = parent;
+    node->set_color((depth == red_depth && depth > 0) ? kRed : kBlack);
+    node->set_count(last - first);
+    node->left_ =
+        BuildBalanced(nodes, first, middle, node, depth + 1, red_depth);
+    node->right_ =
+        BuildBalanced(nodes, middle + 1, last, node, depth + 1, red_depth);
+    return node;
+  }
+
+  void BuildFromSorted(const std::vector<Node *> &nodes) {
+    size_type red_depth = 0;
+    while ((size_type{2} << red_depth) <= nodes.size()) ++red_depth;
+    root_ = BuildBalanced(nodes.data(), 0, nodes.size(), nullptr, 0, red_depth);
+    header_.leftmost_ = nodes.empty() ? nullptr : nodes.front();
+    header_.rightmost_ = nodes.empty() ? nullptr : nodes.back();
   }
 
-  void Swap(Node *other_root) {
-    Node *left_child = this->root_->left_;
-    if (left_child) left_child->parent_ = other_root->right_;
-    Node *right_child = this->root_->right_;
-    if (right_child) right_child->parent_ = other_root->left_;
-    std::swap(this->root_, other_root);
+  // Allocates one detached node per element of [first, last). If one
+  // throws, the nodes made so far are freed before the exception leaves.
+  template <typename InputIt, typename MakeNode>
+  std::vector<Node *> MakeBatch(InputIt first, InputIt last,
+                                MakeNode make_node) {
+    std::vector<Node *> batch;
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      batch.reserve(std::distance(first, last));
+    }
+    try {
+      for (; first != last; ++first) {
+        // The slot comes first, so a node is never made without a home
+        batch.push_back(nullptr);
+        batch.back() = make_node(*first);
+      }
+    } catch (...) {
+      FreeBatch(batch);
+      throw;
+    }
+    return batch;
+  }
+
+  // MakeBatch over a parameter pack: one node per argument, in order
+  template <typename MakeNode, typename... Args>
+  std::vector<Node *> MakePackBatch(MakeNode make_node, const Args &...args) {
+    std::vector<Node *> batch;
+    batch.reserve(sizeof...(args));
+    try {
+      ((batch.push_back(nullptr), batch.back() = make_node(args)), ...);
+    } catch (...) {
+      FreeBatch(batch);
+      throw;
+    }
+    return batch;
+  }
+
+  // Frees the nodes of a batch that was never linked into the tree
+  void FreeBatch(const std::vector<Node *> &batch) {
+    for (Node *node : batch) {
+      if (node != nullptr) storage_.Destroy(node);
+    }
+  }
+
+  /**
+   * Links freshly allocated nodes (in any order) into the tree. If result is
+   * given, it receives for each node, in the original order, the node that
+   * holds its key and whether it was the one inserted. Losers (keys already
+   * present, or repeated within the batch after their first occurrence) are
+   * freed.
+   *
+   * Strictly increasing keys going into an empty tree are linked directly.
+   * Otherwise the batch is sorted unless it already is. If it is large
+   * compared to the tree, both are merge-walked into one sorted node array
+   * and relinked in a single O(n + m) pass; otherwise each node is attached
+   * on its own.
+   */
+  void InsertBatch(const std::vector<Node *> &batch,
+                   std::vector<std::pair<const_iterator, bool>> *result =
+                       nullptr) {
+    size_type count = batch.size();
+    std::vector<std::pair<const_iterator, bool>> ignored;
+    if (result == nullptr) result = &ignored;
+    result->assign(count, {End(), false});
+
+    auto not_increasing = [this](const Node *lhs, const Node *rhs) {
+      return !compare_(lhs->key_, rhs->key_);
+    };
+    if (root_ == nullptr && std::adjacent_find(batch.begin(), batch.end(),
+                                               not_increasing) == batch.end()) {
+      BuildFromSorted(batch);
+      if (result != &ignored) {
+        for (size_type i = 0; i < count; ++i) {
+          (*result)[i] = {MakeIterator(batch[i]), true};
+        }
+      }
+      return;
+    }
+
+    std::vector<size_type> order(count);
+    std::iota(order.begin(), order.end(), size_type{0});
+    auto by_key = [this, &batch](size_type lhs, size_type rhs) {
+      return compare_(batch[lhs]->key_, batch[rhs]->key_);
+    };
+    if (!std::is_sorted(order.begin(), order.end(), by_key)) {
+      std::stable_sort(order.begin(), order.end(), by_key);
+    }
+
+    if (PreferSingleInserts(count)) {
+      for (size_type index : order) {
+        Node *node = batch[index];
+        Node *parent = nullptr;
+        Node *existing = FindSlot(node->key_, &parent);
+        if (existing) {
+          (*result)[index] = {MakeIterator(existing), false};
+          EraseNode(node);
+        } else {
+          AttachNode(node, parent);
+          (*result)[index] = {MakeIterator(node), true};
+        }
+      }
+      return;
+    }
+
+    std::vector<Node *> merged;
+    merged.reserve(Size() + count);
+    Node *existing = Begin().current_;
+    for (size_type index : order) {
+      Node *node = batch[index];
+      while (existing && compare_(existing->key_, node->key_)) {
+        merged.push_back(existing);
+        existing = (++const_iterator(existing)).current_;
+      }
+      if (existing && !compare_(node->key_, existing->key_)) {
+        (*result)[index] = {MakeIterator(existing), false};
+        EraseNode(node);
+      } else if (!merged.empty() &&
+                 !compare_(merged.back()->key_, node->key_)) {
+        (*result)[index] = {MakeIterator(merged.back()), false};
+        EraseNode(node);
+      } else {
+        merged.push_back(node);
+        (*result)[index] = {MakeIterator(node), true};
+      }
+    }
+    for (; existing; existing = (++const_iterator(existing)).current_) {
+      merged.push_back(existing);
+    }
+    BuildFromSorted(merged);
+  }
+
+  // Linking count nodes one by one costs count descents of about log(size)
+  // levels; past that a merge-walk and rebuild of the whole tree is cheaper
+  bool PreferSingleInserts(size_type count) const {
+    size_type size = Size();
+    size_type depth = 1;
+    while ((size_type{1} << depth) <= size) ++depth;
+    return count * depth < size;
   }
 
-  void Merge(Node *other) {
-    if (other == nullptr) {
-      std::cout << "return" << std::endl;
+  // Links freshly allocated nodes (in any order) into a tree that allows
+  // duplicates. Within equal keys the existing nodes come first, then the
+  // batch in its original order.
+  void InsertMultiBatch(std::vector<Node *> batch) {
+    auto by_key = [this](const Node *lhs, const Node *rhs) {
+      return compare_(lhs->key_, rhs->key_);
+    };
+    if (!std::is_sorted(batch.begin(), batch.end(), by_key)) {
+      std::stable_sort(batch.begin(), batch.end(), by_key);
+    }
+    if (PreferSingleInserts(batch.size())) {
+      for (Node *node : batch) AttachNode(node, FindMultiSlot(node->key_));
       return;
     }
-    std::cout << "Merge: " << other->key_ << std::endl;
-    auto move_node = AddNode(other->key_, other->value_);
-    if (move_node.second)
-      std::cout << "true" << std::endl;
-    else
-      std::cout << "false" << std::endl;
-    Merge(other->left_);
-    Merge(other->right_);
-    if (move_node.second) {
-      std::cout << "********SET*********" << std::endl;
-      PrintTree();
-      std::cout << "********OTHER*********" << std::endl;
-      Node *temp = other;
-      while (temp->parent_) {
-        temp = temp->parent_;
-      }
-      PrintHelper(temp);
-      Erase(const_iterator(other));
-    }
-  }
-
-  // void Merge(Node *other) {
-  //   if (other == nullptr) {
-  //     std::cout << "return" << std::endl;
-  //     return;
-  //   }
-  //   std::cout << "Merge: " << other->key_ << std::endl;
-  //   bool move_node = MergeHelper(root_, other, nullptr);
-  //   if (move_node)
-  //     std::cout << "true" << std::endl;
-  //   else
-  //     std::cout << "false" << std::endl;
-  //   Merge(other->left_);
-  //   Merge(other->right_);
-  //   if (move_node) {
-  //     Erase(const_iterator(other));
-  //   }
-  // }
-
-  // bool MergeHelper(Node *current, Node *other, Node *parent) {
-  //   if (current == nullptr) {
-  //     Node *new_node = new Node(other->key_, other->value_);
-  //     new_node->parent_ = parent;
-  //     if
-  //       return true;
-  //   }
-  //   bool result = false;
-  //   // std::cout << "P1" << std::endl;
-  //   if (other->key_ < current->key_) {
-  //     std::cout << other->key_ << " < " << current->key_ << std::endl;
-  //     result = MergeHelper(current->left_, other, current);
-  //     if (result) {
-  //       current->left_ = other;
-  //     }
-  //   } else if (other->key_ > current->key_) {
-  //     std::cout << other->key_ << " > " << current->key_ << std::endl;
-  //     result = MergeHelper(current->right_, other, current);
-  //     if (result) {
-  //       current->right_ = other;
-  //     }
-  //   }
-  //   return result;
-  // }
+    std::vector<Node *> merged;
+    merged.reserve(Size() + batch.size());
+    Node *existing = header_.leftmost_;
+    for (Node *node : batch) {
+      while (existing && !compare_(node->key_, existing->key_)) {
+        merged.push_back(existing);
+        existing = (++const_iterator(existing)).current_;
+      }
+      merged.push_back(node);
+    }
+    for (; existing; existing = (++const_iterator(existing)).current_) {
+      merged.push_back(existing);
+    }
+    BuildFromSorted(merged);
+  }
 
+  // Copies the subtree of source node by node, walking source and copy in
+  // lockstep through parent pointers instead of recursing
   Node *CopyTree(Node *source, Node *parent) {
     if (source == nullptr) {
       return nullptr;
     }
-    Node *temp = new Node(source->key_, source->value_);
+    Node *copy = CloneNode(source, parent);
+    Node *from = source;
+    Node *to = copy;
+    while (true) {
+      if (from->left_ && !to->left_) {
+        to->left_ = CloneNode(from->left_, to);
+        from = from->left_;
+        to = to->left_;
+      } else if (from->right_ && !to->right_) {
+        to->right_ = CloneNode(from->right_, to);
+        from = from->right_;
+        to = to->right_;
+      } else if (from != source) {
+        from = from->parent_;
+        to = to->parent_;
+      } else {
+        break;
+      }
+    }
+    return copy;
+  }
+
+  Node *CloneNode(const Node *source, Node *parent) {
+    Node *temp = CreateNode(static_cast<const NodeData &>(*source));
     temp->parent_ = parent;
-    temp->left_ = CopyTree(source->left_, temp);
-    temp->right_ = CopyTree(source->right_, temp);
+    temp->set_color(source->color());
+    temp->set_count(source->count());
     return temp;
   }
 
@@ -409,7 +1604,9 @@ class BinaryTree {
     }
     std::cout << "Structure:" << std::endl;
     std::cout << "key = " << tree->key_ << std::endl;
-    std::cout << "value = " << tree->value_ << std::endl;
+    if constexpr (!std::is_void_v<T>) {
+      std::cout << "value = " << tree->value_ << std::endl;
+    }
     std::cout << "&parent = " << tree->parent_ << std::endl;
     std::cout << "&left = " << tree->left_ << std::endl;
     std::cout << "&right = " << tree->right_ << std::endl;
@@ -0,0 +1,37 @@
+#ifndef S21_CONTAINERS_H_S21_TREE_BALANCE_H
+#define S21_CONTAINERS_H_S21_TREE_BALANCE_H
+
+/**
+ * @file s21_tree_balance.h
+ * @brief Balancing policies for the tree based containers
+ * @details BinaryTree keeps its shape with one of these:
+ *
+ * - RedBlackBalance (default) guarantees O(log n) depth for every key. A
+ * lookup never changes the tree, so const member functions are truly
+ * read-only.
+ *
+ * - SplayBalance drops the colour invariants and instead rotates every
+ * node that is inserted or found to the root (zig, zig-zig and zig-zag
+ * steps). Operations are O(log n) amortized and a key accessed often stays
+ * near the root. The rotations write to every node on the path, though, so
+ * lookups only win when they would otherwise miss the cache; measure with
+ * benchmarks/s21_splay_benchmark.cc before switching. Because find() and
+ * contains() restructure the tree, a splay set or map only offers them on
+ * a non-const container; calling them through a const reference does not
+ * compile. Even plain lookups are writes, so a splay container must not be
+ * read from two threads at once.
+ */
+
+namespace s21 {
+
+struct RedBlackBalance {
+  static constexpr bool kSelfAdjusting = false;
+};
+
+struct SplayBalance {
+  static constexpr bool kSelfAdjusting = true;
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_H_S21_TREE_BALANCE_H
@@ -0,0 +1,82 @@
+#ifndef COMPONENTS_S21_UNORDERED_MAP_H
+#define COMPONENTS_S21_UNORDERED_MAP_H
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_hash_table.h"
+
+namespace s21 {
+/**
+ * Hash map on an open addressing table (see HashTable). Iterators behave
+ * like s21::map ones: *it is the key and it->value_ the mapped value. With
+ * a Hash and KeyEqual that declare is_transparent, such as
+ * std::equal_to<>, find(), contains() and count() take any key type they
+ * accept.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class unordered_map : public HashTable<Key, Value, Hash, KeyEqual> {
+ private:
+  using Base = HashTable<Key, Value, Hash, KeyEqual>;
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = typename Base::size_type;
+  using const_iterator = typename Base::const_iterator;
+
+ public:
+  unordered_map() = default;
+  // Room for capacity entries before the first growth
+  explicit unordered_map(size_type capacity, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual())
+      : Base(capacity, hash, equal) {}
+  unordered_map(std::initializer_list<value_type> const &key_value_pairs)
+      : unordered_map(key_value_pairs.begin(), key_value_pairs.end()) {}
+  template <typename InputIt>
+  unordered_map(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  mapped_type &at(const key_type &key) {
+    const_iterator it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("unordered_map::at: key not found");
+    }
+    return const_cast<mapped_type &>(it->value_);
+  }
+
+  // Inserts a value-initialized mapped value if key is missing
+  mapped_type &operator[](const key_type &key) {
+    return const_cast<mapped_type &>(this->Emplace(key).first->value_);
+  }
+
+  std::pair<const_iterator, bool> insert(const value_type &kvp) {
+    return this->Emplace(kvp.first, kvp.second);
+  }
+  std::pair<const_iterator, bool> insert(const key_type &key,
+                                         const mapped_type &value) {
+    return this->Emplace(key, value);
+  }
+
+  template <typename... Args>
+  std::pair<const_iterator, bool> try_emplace(const key_type &key,
+                                              Args &&...args) {
+    return this->Emplace(key, std::forward<Args>(args)...);
+  }
+
+  template <typename M>
+  std::pair<const_iterator, bool> insert_or_assign(const key_type &key,
+                                                   M &&value) {
+    auto result = this->Emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      const_cast<mapped_type &>(result.first->value_) = std::forward<M>(value);
+    }
+    return result;
+  }
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_UNORDERED_MAP_H
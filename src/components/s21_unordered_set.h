@@ -0,0 +1,45 @@
+#ifndef COMPONENTS_S21_UNORDERED_SET_H
+#define COMPONENTS_S21_UNORDERED_SET_H
+
+#include <functional>
+#include <initializer_list>
+
+#include "s21_hash_table.h"
+
+namespace s21 {
+/**
+ * Hash set on an open addressing table (see HashTable). With a Hash and
+ * KeyEqual that declare is_transparent, such as std::equal_to<>, find(),
+ * contains() and count() take any key type they accept.
+ */
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class unordered_set : public HashTable<Key, void, Hash, KeyEqual> {
+ private:
+  using Base = HashTable<Key, void, Hash, KeyEqual>;
+  using key_type = Key;
+  using value_type = Key;
+  using size_type = typename Base::size_type;
+  using const_iterator = typename Base::const_iterator;
+
+ public:
+  unordered_set() = default;
+  // Room for capacity keys before the first growth
+  explicit unordered_set(size_type capacity, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual())
+      : Base(capacity, hash, equal) {}
+  unordered_set(std::initializer_list<value_type> const &items)
+      : unordered_set(items.begin(), items.end()) {}
+  template <typename InputIt>
+  unordered_set(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  std::pair<const_iterator, bool> insert(const value_type &value) {
+    return this->Emplace(value);
+  }
+};
+
+}  // namespace s21
+
+#endif  // COMPONENTS_S21_UNORDERED_SET_H
@@ -20,11 +20,11 @@ template <typename T>
 class vector : public SequenceContainer<vector<T>, T> {
  private:
   // Vector Member type
-  using value_type = typename SequenceContainer<list<T>, T>::value_type;
-  using reference = typename SequenceContainer<list<T>, T>::reference;
+  using value_type = typename SequenceContainer<vector<T>, T>::value_type;
+  using reference = typename SequenceContainer<vector<T>, T>::reference;
   using const_reference =
-      typename SequenceContainer<list<T>, T>::const_reference;
-  using size_type = typename SequenceContainer<list<T>, T>::size_type;
+      typename SequenceContainer<vector<T>, T>::const_reference;
+  using size_type = typename SequenceContainer<vector<T>, T>::size_type;
 
   using iterator = T*;
   using const_iterator = const T*;
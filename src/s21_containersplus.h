@@ -7,5 +7,18 @@
 // 4) other libraries' headers
 // 5) project's headers.
 #include "components/s21_array.h"
+#include "components/s21_btree_map.h"
+#include "components/s21_btree_set.h"
+#include "components/s21_flat_map.h"
+#include "components/s21_flat_set.h"
+#include "components/s21_multimap.h"
+#include "components/s21_multiset.h"
+#include "components/s21_parallel.h"
+#include "components/s21_persistent_map.h"
+#include "components/s21_set_algebra.h"
+#include "components/s21_small_map.h"
+#include "components/s21_small_set.h"
+#include "components/s21_unordered_map.h"
+#include "components/s21_unordered_set.h"
 
 #endif  // CPP2_S21CONTAINERS_S21_CONTAINERSPLUS_H_
@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "s21_containersplus.h"
+
+// 16-byte nodes hold 4 int keys, so a few hundred keys already make a tree
+// several levels deep
+template <typename T>
+using TinyBtreeSet = s21::btree_set<T, std::less<T>, 16>;
+
+template <typename Set, typename T>
+void CompareBtreeSets(const Set &ActualSet, const std::set<T> &ExpectedSet) {
+  ASSERT_EQ(ActualSet.size(), ExpectedSet.size());
+  EXPECT_TRUE(std::equal(ActualSet.begin(), ActualSet.end(),
+                         ExpectedSet.begin(), ExpectedSet.end()));
+  EXPECT_TRUE(std::equal(ActualSet.rbegin(), ActualSet.rend(),
+                         ExpectedSet.rbegin(), ExpectedSet.rend()));
+}
+
+TEST(BtreeSetTest, RandomMatchesStdSet) {
+  std::mt19937 gen(23);
+  TinyBtreeSet<int> ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 2000) - 1000;
+    switch (gen() % 4) {
+      case 0:
+        ASSERT_EQ(ActualSet.erase(key), ExpectedSet.erase(key));
+        break;
+      case 1: {
+        auto actual = ActualSet.lower_bound(key);
+        auto expected = ExpectedSet.lower_bound(key);
+        if (expected == ExpectedSet.end()) {
+          ASSERT_EQ(actual, ActualSet.end());
+        } else {
+          ASSERT_EQ(*actual, *expected);
+          // erase(pos) returns the follower, also across a rebalance
+          auto next = ActualSet.erase(actual);
+          expected = ExpectedSet.erase(expected);
+          if (expected == ExpectedSet.end()) {
+            ASSERT_EQ(next, ActualSet.end());
+          } else {
+            ASSERT_EQ(*next, *expected);
+          }
+        }
+        break;
+      }
+      default:
+        ASSERT_EQ(ActualSet.insert(key).second,
+                  ExpectedSet.insert(key).second);
+    }
+    ASSERT_EQ(ActualSet.size(), ExpectedSet.size());
+  }
+  CompareBtreeSets(ActualSet, ExpectedSet);
+  for (int key = -1001; key <= 1001; ++key) {
+    auto actual = ActualSet.upper_bound(key);
+    auto expected = ExpectedSet.upper_bound(key);
+    ASSERT_EQ(actual == ActualSet.end(), expected == ExpectedSet.end());
+    if (expected != ExpectedSet.end()) {
+      ASSERT_EQ(*actual, *expected);
+    }
+  }
+}
+
+TEST(BtreeSetTest, GrowsAndShrinksInOrder) {
+  TinyBtreeSet<int> ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 5000; ++i) {
+    ActualSet.insert(i);
+    ExpectedSet.insert(i);
+  }
+  CompareBtreeSets(ActualSet, ExpectedSet);
+  for (int i = 4999; i >= 0; i -= 2) {
+    ActualSet.erase(i);
+    ExpectedSet.erase(i);
+  }
+  CompareBtreeSets(ActualSet, ExpectedSet);
+  while (!ActualSet.empty()) ActualSet.erase(ActualSet.begin());
+  EXPECT_EQ(ActualSet.begin(), ActualSet.end());
+  ActualSet.insert(1);
+  EXPECT_EQ(*ActualSet.begin(), 1);
+}
+
+TEST(BtreeSetTest, PageSizedNodes) {
+  std::mt19937 gen(5);
+  s21::btree_set<int, std::less<int>, 4096> ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 100000; ++i) {
+    int key = static_cast<int>(gen() % 50000);
+    if (i % 4 == 0) {
+      ASSERT_EQ(ActualSet.erase(key), ExpectedSet.erase(key));
+    } else {
+      ActualSet.insert(key);
+      ExpectedSet.insert(key);
+    }
+  }
+  CompareBtreeSets(ActualSet, ExpectedSet);
+  for (int key = -1; key <= 50000; key += 7) {
+    ASSERT_EQ(ActualSet.contains(key), ExpectedSet.count(key) == 1);
+    auto actual = ActualSet.upper_bound(key);
+    auto expected = ExpectedSet.upper_bound(key);
+    ASSERT_EQ(actual == ActualSet.end(), expected == ExpectedSet.end());
+    if (expected != ExpectedSet.end()) {
+      ASSERT_EQ(*actual, *expected);
+    }
+  }
+}
+
+TEST(BtreeSetTest, EraseRange) {
+  TinyBtreeSet<int> ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 1000; ++i) {
+    ActualSet.insert(i);
+    ExpectedSet.insert(i);
+  }
+  auto next = ActualSet.erase(ActualSet.lower_bound(100),
+                              ActualSet.lower_bound(900));
+  ExpectedSet.erase(ExpectedSet.lower_bound(100),
+                    ExpectedSet.lower_bound(900));
+  EXPECT_EQ(*next, 900);
+  CompareBtreeSets(ActualSet, ExpectedSet);
+  EXPECT_EQ(ActualSet.erase(ActualSet.lower_bound(950), ActualSet.end()),
+            ActualSet.end());
+  ExpectedSet.erase(ExpectedSet.lower_bound(950), ExpectedSet.end());
+  CompareBtreeSets(ActualSet, ExpectedSet);
+}
+
+TEST(BtreeSetTest, StringAndFloatKeys) {
+  std::mt19937 gen(7);
+  s21::btree_set<std::string, std::less<std::string>, 64> ActualStrings;
+  std::set<std::string> ExpectedStrings;
+  TinyBtreeSet<float> ActualFloats;
+  std::set<float> ExpectedFloats;
+  for (int i = 0; i < 3000; ++i) {
+    std::string key = "key" + std::to_string(gen() % 1000);
+    float number = static_cast<float>(gen() % 1000) / 8;
+    if (i % 3 == 0) {
+      ASSERT_EQ(ActualStrings.erase(key), ExpectedStrings.erase(key));
+      ASSERT_EQ(ActualFloats.erase(number), ExpectedFloats.erase(number));
+    } else {
+      ActualStrings.insert(key);
+      ExpectedStrings.insert(key);
+      ActualFloats.insert(number);
+      ExpectedFloats.insert(number);
+    }
+  }
+  CompareBtreeSets(ActualStrings, ExpectedStrings);
+  CompareBtreeSets(ActualFloats, ExpectedFloats);
+  EXPECT_EQ(*ActualFloats.lower_bound(10.01f),
+            *ExpectedFloats.lower_bound(10.01f));
+}
+
+TEST(BtreeSetTest, CopyAndMove) {
+  TinyBtreeSet<int> Original;
+  for (int i = 0; i < 500; ++i) Original.insert(i * 3);
+  TinyBtreeSet<int> Copy(Original);
+  Copy.erase(0);
+  EXPECT_EQ(Original.size(), 500U);
+  EXPECT_EQ(Copy.size(), 499U);
+  EXPECT_EQ(*--Copy.end(), 1497);
+  EXPECT_EQ(*Copy.begin(), 3);
+
+  TinyBtreeSet<int> Moved(std::move(Copy));
+  EXPECT_EQ(Moved.size(), 499U);
+  EXPECT_TRUE(Copy.empty());
+  Copy = Moved;
+  Moved = std::move(Original);
+  EXPECT_EQ(*Moved.begin(), 0);
+  EXPECT_EQ(*Copy.begin(), 3);
+  EXPECT_EQ(std::distance(Copy.begin(), Copy.end()), 499);
+}
+
+TEST(BtreeMapTest, MapInterface) {
+  s21::btree_map<int, std::string> ActualMap = {{2, "two"}, {1, "one"}};
+  EXPECT_EQ(ActualMap.at(2), "two");
+  EXPECT_THROW(ActualMap.at(3), std::out_of_range);
+  ActualMap[3] = "three";
+  EXPECT_FALSE(ActualMap.insert(3, "drei").second);
+  EXPECT_FALSE(ActualMap.insert_or_assign(3, "drei").second);
+  EXPECT_TRUE(ActualMap.try_emplace(4, 3, 'x').second);
+
+  auto it = ActualMap.begin();
+  EXPECT_EQ(*it, 1);
+  EXPECT_EQ(it->value_, "one");
+  EXPECT_EQ(ActualMap.find(3)->value_, "drei");
+  EXPECT_EQ(ActualMap.rbegin()->value_, "xxx");
+}
+
+TEST(BtreeMapTest, RandomMatchesStdMap) {
+  std::mt19937 gen(41);
+  s21::btree_map<int, int, std::less<int>, 32> ActualMap;
+  std::map<int, int> ExpectedMap;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 3000);
+    if (gen() % 3 == 0) {
+      ASSERT_EQ(ActualMap.erase(key), ExpectedMap.erase(key));
+    } else {
+      ActualMap[key] += i;
+      ExpectedMap[key] += i;
+    }
+  }
+  ASSERT_EQ(ActualMap.size(), ExpectedMap.size());
+  auto expected = ExpectedMap.begin();
+  for (auto it = ActualMap.begin(); it != ActualMap.end(); ++it, ++expected) {
+    ASSERT_EQ(*it, expected->first);
+    ASSERT_EQ(it->value_, expected->second);
+  }
+}
+
+// The drop-in claim: code written against s21::map compiles unchanged
+template <typename Map>
+int SumRange(const Map &map, int low, int high) {
+  int sum = 0;
+  for (auto it = map.lower_bound(low); it != map.end() && *it < high; ++it) {
+    sum += it->value_;
+  }
+  return sum;
+}
+
+TEST(BtreeMapTest, SwapsWithS21Map) {
+  s21::map<int, int> TreeMap;
+  s21::btree_map<int, int> BtreeMap;
+  for (int i = 0; i < 1000; ++i) {
+    TreeMap.insert(i, i * 2);
+    BtreeMap.insert(i, i * 2);
+  }
+  EXPECT_EQ(SumRange(TreeMap, 100, 200), SumRange(BtreeMap, 100, 200));
+}
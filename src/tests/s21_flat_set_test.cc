@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "s21_containersplus.h"
+
+template <typename T>
+void CompareFlatSets(const s21::flat_set<T> &ActualSet,
+                     const std::set<T> &ExpectedSet) {
+  ASSERT_EQ(ActualSet.size(), ExpectedSet.size());
+  EXPECT_TRUE(std::equal(ActualSet.begin(), ActualSet.end(),
+                         ExpectedSet.begin(), ExpectedSet.end()));
+  EXPECT_TRUE(std::equal(ActualSet.rbegin(), ActualSet.rend(),
+                         ExpectedSet.rbegin(), ExpectedSet.rend()));
+}
+
+// equal_range is one search plus a comparison, not two searches
+TEST(FlatSetTest, EqualRange) {
+  s21::flat_set<int> ActualSet = {1, 2, 3, 4, 5};
+  auto [first, last] = ActualSet.equal_range(3);
+  EXPECT_EQ(*first, 3);
+  EXPECT_EQ(*last, 4);
+  auto [missing, missing_end] = ActualSet.equal_range(6);
+  EXPECT_EQ(missing, ActualSet.end());
+  EXPECT_EQ(missing_end, ActualSet.end());
+  auto [before, before_end] = ActualSet.equal_range(0);
+  EXPECT_EQ(before, ActualSet.begin());
+  EXPECT_EQ(before_end, ActualSet.begin());
+}
+
+TEST(FlatSetTest, EmptySet) {
+  s21::flat_set<int> ActualSet;
+  EXPECT_EQ(ActualSet.begin(), ActualSet.end());
+  EXPECT_EQ(ActualSet.find(1), ActualSet.end());
+  EXPECT_EQ(ActualSet.upper_bound(1), ActualSet.end());
+  EXPECT_EQ(ActualSet.erase(1), 0U);
+  std::vector<int> none;
+  ActualSet.insert(none.begin(), none.end());
+  EXPECT_TRUE(ActualSet.empty());
+}
+
+TEST(FlatSetTest, RandomMatchesStdSet) {
+  std::mt19937 gen(24);
+  s21::flat_set<int> ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 5000; ++i) {
+    int key = static_cast<int>(gen() % 1000);
+    switch (gen() % 4) {
+      case 0:
+        ASSERT_EQ(ActualSet.erase(key), ExpectedSet.erase(key));
+        break;
+      case 1: {
+        std::vector<int> batch;
+        for (int j = 0; j < 20; ++j) batch.push_back(gen() % 1000);
+        ActualSet.insert(batch.begin(), batch.end());
+        ExpectedSet.insert(batch.begin(), batch.end());
+        break;
+      }
+      default:
+        ASSERT_EQ(ActualSet.insert(key).second,
+                  ExpectedSet.insert(key).second);
+    }
+    ASSERT_EQ(ActualSet.size(), ExpectedSet.size());
+  }
+  CompareFlatSets(ActualSet, ExpectedSet);
+  for (int key = -1; key <= 1000; ++key) {
+    ASSERT_EQ(ActualSet.contains(key), ExpectedSet.count(key) == 1);
+    auto actual = ActualSet.upper_bound(key);
+    auto expected = ExpectedSet.upper_bound(key);
+    ASSERT_EQ(actual == ActualSet.end(), expected == ExpectedSet.end());
+    if (expected != ExpectedSet.end()) {
+      ASSERT_EQ(*actual, *expected);
+    }
+  }
+}
+
+TEST(FlatSetTest, BulkInsertMergesInPlace) {
+  s21::flat_set<std::string> ActualSet = {"b", "d", "f"};
+  ActualSet.reserve(16);
+  std::vector<std::string> batch = {"e", "a", "d", "g", "a", "c"};
+  ActualSet.insert(batch.begin(), batch.end());
+  EXPECT_EQ(ActualSet.capacity(), 16U);
+  CompareFlatSets(ActualSet,
+                  std::set<std::string>{"a", "b", "c", "d", "e", "f", "g"});
+
+  ActualSet.shrink_to_fit();
+  EXPECT_EQ(ActualSet.capacity(), 7U);
+  std::vector<std::string> appended = {"x", "y", "z"};
+  ActualSet.insert(appended.begin(), appended.end());
+  EXPECT_EQ(*--ActualSet.end(), "z");
+  EXPECT_EQ(ActualSet.size(), 10U);
+}
+
+TEST(FlatSetTest, EraseReturnsFollower) {
+  s21::flat_set<int> ActualSet = {1, 2, 3, 4, 5, 6};
+  auto next = ActualSet.erase(ActualSet.find(2));
+  EXPECT_EQ(*next, 3);
+  next = ActualSet.erase(ActualSet.find(3), ActualSet.find(6));
+  EXPECT_EQ(*next, 6);
+  next = ActualSet.erase(ActualSet.find(6));
+  EXPECT_EQ(next, ActualSet.end());
+  CompareFlatSets(ActualSet, std::set<int>{1});
+}
+
+TEST(FlatSetTest, CopyAndMove) {
+  s21::flat_set<int> Original = {3, 1, 2};
+  s21::flat_set<int> Copy(Original);
+  Copy.erase(1);
+  EXPECT_EQ(Original.size(), 3U);
+  s21::flat_set<int> Moved(std::move(Copy));
+  EXPECT_TRUE(Copy.empty());
+  Copy = Original;
+  Original = std::move(Moved);
+  CompareFlatSets(Copy, std::set<int>{1, 2, 3});
+  CompareFlatSets(Original, std::set<int>{2, 3});
+}
+
+TEST(FlatMapTest, MapInterface) {
+  s21::flat_map<int, std::string> ActualMap = {{2, "two"}, {1, "one"}};
+  EXPECT_EQ(ActualMap.at(2), "two");
+  EXPECT_THROW(ActualMap.at(3), std::out_of_range);
+  ActualMap[3] = "three";
+  EXPECT_FALSE(ActualMap.insert(3, "drei").second);
+  EXPECT_FALSE(ActualMap.insert_or_assign(3, "drei").second);
+  EXPECT_TRUE(ActualMap.try_emplace(4, 3, 'x').second);
+
+  auto it = ActualMap.begin();
+  EXPECT_EQ(*it, 1);
+  EXPECT_EQ(it->value_, "one");
+  EXPECT_EQ(ActualMap.find(3)->value_, "drei");
+  EXPECT_EQ(ActualMap.rbegin()->value_, "xxx");
+}
+
+// Copy assignment throws while fail is set, moves never do
+struct Touchy {
+  static inline bool fail = false;
+  int value = 0;
+
+  Touchy() = default;
+  explicit Touchy(int v) : value(v) {}
+  Touchy(const Touchy &other) = default;
+  Touchy(Touchy &&other) = default;
+  Touchy &operator=(const Touchy &other) {
+    if (fail) throw std::runtime_error("copy");
+    value = other.value;
+    return *this;
+  }
+  Touchy &operator=(Touchy &&other) = default;
+};
+
+TEST(FlatMapTest, ThrowingEmplaceChangesNothing) {
+  s21::flat_map<int, Touchy> ActualMap;
+  ActualMap.reserve(8);
+  ActualMap.try_emplace(1, 10);
+  ActualMap.try_emplace(3, 30);
+
+  Touchy::fail = true;
+  EXPECT_THROW(ActualMap.try_emplace(2, 20), std::runtime_error);
+  Touchy::fail = false;
+  ASSERT_EQ(ActualMap.size(), 2U);
+  EXPECT_FALSE(ActualMap.contains(2));
+  EXPECT_EQ(ActualMap.find(3)->value_.value, 30);
+
+  EXPECT_TRUE(ActualMap.try_emplace(2, 20).second);
+  int expected = 10;
+  for (auto it = ActualMap.begin(); it != ActualMap.end(); ++it) {
+    EXPECT_EQ(it->value_.value, expected);
+    expected += 10;
+  }
+}
+
+TEST(FlatMapTest, BulkInsertKeepsFirstValue) {
+  s21::flat_map<int, std::string> ActualMap = {{5, "five"}};
+  std::vector<std::pair<int, std::string>> batch = {
+      {3, "three"}, {5, "cinq"}, {3, "trois"}, {1, "one"}};
+  ActualMap.insert(batch.begin(), batch.end());
+  std::map<int, std::string> ExpectedMap = {{5, "five"}};
+  ExpectedMap.insert(batch.begin(), batch.end());
+  ASSERT_EQ(ActualMap.size(), ExpectedMap.size());
+  auto expected = ExpectedMap.begin();
+  for (auto it = ActualMap.begin(); it != ActualMap.end(); ++it, ++expected) {
+    EXPECT_EQ(*it, expected->first);
+    EXPECT_EQ(it->value_, expected->second);
+  }
+}
+
+TEST(FlatMapTest, RandomMatchesStdMap) {
+  std::mt19937 gen(42);
+  s21::flat_map<int, int> ActualMap;
+  std::map<int, int> ExpectedMap;
+  for (int i = 0; i < 5000; ++i) {
+    int key = static_cast<int>(gen() % 700);
+    if (gen() % 3 == 0) {
+      ASSERT_EQ(ActualMap.erase(key), ExpectedMap.erase(key));
+    } else {
+      ActualMap[key] += i;
+      ExpectedMap[key] += i;
+    }
+  }
+  ASSERT_EQ(ActualMap.size(), ExpectedMap.size());
+  auto expected = ExpectedMap.begin();
+  for (auto it = ActualMap.begin(); it != ActualMap.end(); ++it, ++expected) {
+    ASSERT_EQ(*it, expected->first);
+    ASSERT_EQ(it->value_, expected->second);
+  }
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "s21_containersplus.h"
+
+template <typename T>
+void CompareMultisets(const s21::multiset<T> &ActualSet,
+                      const std::multiset<T> &ExpectedSet) {
+  ASSERT_EQ(ActualSet.size(), ExpectedSet.size());
+  auto expected = ExpectedSet.begin();
+  for (auto it = ActualSet.begin(); it != ActualSet.end(); ++it, ++expected) {
+    EXPECT_EQ(*it, *expected);
+  }
+}
+
+TEST(MultisetTest, InsertKeepsDuplicates) {
+  s21::multiset<int> ActualSet = {5, 1, 5, 3, 1, 5};
+  std::multiset<int> ExpectedSet = {5, 1, 5, 3, 1, 5};
+
+  CompareMultisets(ActualSet, ExpectedSet);
+  EXPECT_EQ(ActualSet.count(5), 3U);
+  EXPECT_EQ(ActualSet.count(1), 2U);
+  EXPECT_EQ(ActualSet.count(4), 0U);
+  EXPECT_TRUE(ActualSet.contains(3));
+
+  auto it = ActualSet.insert(3);
+  EXPECT_EQ(*it, 3);
+  EXPECT_EQ(ActualSet.count(3), 2U);
+  EXPECT_EQ(ActualSet.size(), 7U);
+}
+
+TEST(MultisetTest, EqualRange) {
+  s21::multiset<int> ActualSet = {1, 2, 2, 2, 3, 5};
+
+  auto [first, last] = ActualSet.equal_range(2);
+  int seen = 0;
+  for (; first != last; ++first, ++seen) EXPECT_EQ(*first, 2);
+  EXPECT_EQ(seen, 3);
+  EXPECT_EQ(*last, 3);
+
+  auto missing = ActualSet.equal_range(4);
+  EXPECT_EQ(missing.first, missing.second);
+  EXPECT_EQ(*missing.first, 5);
+  EXPECT_EQ(*ActualSet.find(2), 2);
+  EXPECT_EQ(ActualSet.find(2), ActualSet.lower_bound(2));
+}
+
+TEST(MultisetTest, RandomMatchesStdMultiset) {
+  std::mt19937 gen(13);
+  s21::multiset<int> ActualSet;
+  std::multiset<int> ExpectedSet;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 500);
+    if (gen() % 4 == 0 && ActualSet.contains(key)) {
+      ActualSet.erase(ActualSet.find(key));
+      ExpectedSet.erase(ExpectedSet.find(key));
+    } else {
+      ActualSet.insert(key);
+      ExpectedSet.insert(key);
+    }
+  }
+
+  CompareMultisets(ActualSet, ExpectedSet);
+  for (int key = 0; key < 500; ++key) {
+    ASSERT_EQ(ActualSet.count(key), ExpectedSet.count(key));
+  }
+  for (size_t k = 0; k < ActualSet.size(); k += 97) {
+    EXPECT_EQ(*ActualSet.nth(k), *std::next(ExpectedSet.begin(), k));
+  }
+}
+
+TEST(MultisetTest, RangeConstructorAndInsertMany) {
+  std::vector<int> keys = {9, 2, 7, 2, 9, 9, 1};
+  s21::multiset<int> ActualSet(keys.begin(), keys.end());
+  std::multiset<int> ExpectedSet(keys.begin(), keys.end());
+  CompareMultisets(ActualSet, ExpectedSet);
+
+  auto result = ActualSet.insert_many(7, 7, 0);
+  ExpectedSet.insert({7, 7, 0});
+  ASSERT_EQ(result.size(), 3U);
+  EXPECT_TRUE(result[0].second);
+  EXPECT_EQ(*result[2].first, 0);
+  CompareMultisets(ActualSet, ExpectedSet);
+}
+
+TEST(MultisetTest, CopyMoveSwap) {
+  s21::multiset<std::string> ActualSet1 = {"b", "a", "b"};
+  s21::multiset<std::string> CopySet(ActualSet1);
+  s21::multiset<std::string> MoveSet(std::move(ActualSet1));
+  EXPECT_EQ(CopySet.count("b"), 2U);
+  EXPECT_EQ(MoveSet.size(), 3U);
+  EXPECT_TRUE(ActualSet1.empty());
+
+  s21::multiset<std::string> ActualSet2 = {"z"};
+  ActualSet2.swap(MoveSet);
+  EXPECT_EQ(ActualSet2.size(), 3U);
+  EXPECT_EQ(*MoveSet.begin(), "z");
+}
+
+TEST(MultisetTest, MergeTakesEverything) {
+  s21::multiset<int> ActualSet1 = {1, 3, 3};
+  s21::multiset<int> ActualSet2 = {3, 2, 1, 4};
+
+  ActualSet1.merge(ActualSet2);
+  EXPECT_TRUE(ActualSet2.empty());
+  CompareMultisets(ActualSet1, std::multiset<int>({1, 1, 2, 3, 3, 3, 4}));
+
+  auto node = ActualSet1.extract(3);
+  ActualSet2.insert(std::move(node));
+  EXPECT_EQ(ActualSet1.count(3), 2U);
+  EXPECT_EQ(ActualSet2.count(3), 1U);
+}
+
+TEST(MultimapTest, EqualKeysKeepInsertionOrder) {
+  s21::multimap<int, std::string> ActualMap;
+  std::multimap<int, std::string> ExpectedMap;
+  std::mt19937 gen(14);
+  for (int i = 0; i < 5000; ++i) {
+    int key = static_cast<int>(gen() % 50);
+    ActualMap.insert(key, std::to_string(i));
+    ExpectedMap.emplace(key, std::to_string(i));
+  }
+
+  ASSERT_EQ(ActualMap.size(), ExpectedMap.size());
+  auto expected = ExpectedMap.begin();
+  for (auto it = ActualMap.begin(); it != ActualMap.end(); ++it, ++expected) {
+    ASSERT_EQ(*it, expected->first);
+    ASSERT_EQ(it->value_, expected->second);
+  }
+  EXPECT_EQ(ActualMap.count(7), ExpectedMap.count(7));
+}
+
+TEST(MultimapTest, MergeAndBulkBuildAreStable) {
+  s21::multimap<int, char> ActualMap = {{2, 'a'}, {1, 'b'}, {2, 'c'}};
+  s21::multimap<int, char> OtherMap = {{2, 'd'}, {0, 'e'}};
+  ActualMap.emplace(2, 'f');
+  ActualMap.merge(OtherMap);
+
+  std::string values;
+  for (auto [it, last] = ActualMap.equal_range(2); it != last; ++it) {
+    values += it->value_;
+  }
+  EXPECT_EQ(values, "acfd");
+  EXPECT_EQ(*ActualMap.begin(), 0);
+  EXPECT_EQ(ActualMap.size(), 6U);
+  EXPECT_TRUE(OtherMap.empty());
+}
+
+TEST(MultisetTest, EraseKeyRangeAndIf) {
+  s21::multiset<int> ActualSet;
+  std::multiset<int> ExpectedSet;
+  for (int i = 0; i < 6000; ++i) {
+    ActualSet.insert(i % 600);
+    ExpectedSet.insert(i % 600);
+  }
+  EXPECT_EQ(ActualSet.erase(42), 10U);
+  ExpectedSet.erase(42);
+  EXPECT_EQ(ActualSet.erase(42), 0U);
+
+  // Starts in the middle of a run of equal keys
+  auto first = std::next(ActualSet.find(100), 3);
+  ActualSet.erase(first, ActualSet.find(300));
+  ExpectedSet.erase(std::next(ExpectedSet.find(100), 3),
+                    ExpectedSet.find(300));
+  CompareMultisets(ActualSet, ExpectedSet);
+
+  EXPECT_EQ(s21::erase_if(ActualSet,
+                          [](const auto &entry) { return entry.key_ < 50; }),
+            490U);
+  ExpectedSet.erase(ExpectedSet.begin(), ExpectedSet.lower_bound(50));
+  CompareMultisets(ActualSet, ExpectedSet);
+}
+
+TEST(MultimapTest, EraseKeepsOrderOfSurvivors) {
+  s21::multimap<int, char> ActualMap = {
+      {1, 'a'}, {2, 'b'}, {1, 'c'}, {2, 'd'}, {1, 'e'}};
+  EXPECT_EQ(s21::erase_if(ActualMap,
+                          [](const auto &entry) {
+                            return entry.value_ == 'c';
+                          }),
+            1U);
+  std::string values;
+  for (auto it = ActualMap.begin(); it != ActualMap.end(); ++it) {
+    values += it->value_;
+  }
+  EXPECT_EQ(values, "aebd");
+  EXPECT_EQ(ActualMap.erase(2), 2U);
+  EXPECT_EQ(ActualMap.size(), 2U);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+#include "s21_containersplus.h"
+
+// The contract every sorted set of unique keys keeps, whatever its layout.
+// Container specific behaviour is tested in the container's own file.
+template <typename Set>
+class OrderedSetTest : public ::testing::Test {
+ protected:
+  static void CompareSets(const Set &ActualSet,
+                          const std::set<int> &ExpectedSet) {
+    ASSERT_EQ(ActualSet.size(), ExpectedSet.size());
+    EXPECT_TRUE(std::equal(ActualSet.begin(), ActualSet.end(),
+                           ExpectedSet.begin(), ExpectedSet.end()));
+  }
+};
+
+using OrderedSets =
+    ::testing::Types<s21::btree_set<int>, s21::flat_set<int>,
+                     s21::small_set<int>>;
+TYPED_TEST_SUITE(OrderedSetTest, OrderedSets);
+
+TYPED_TEST(OrderedSetTest, InsertAndLookup) {
+  TypeParam ActualSet = {5, 1, 4, 1, 3};
+  EXPECT_EQ(ActualSet.size(), 4U);
+  EXPECT_FALSE(ActualSet.insert(4).second);
+  auto [it, inserted] = ActualSet.insert(2);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*it, 2);
+  this->CompareSets(ActualSet, std::set<int>{1, 2, 3, 4, 5});
+
+  EXPECT_TRUE(ActualSet.contains(3));
+  EXPECT_FALSE(ActualSet.contains(6));
+  EXPECT_EQ(*ActualSet.find(3), 3);
+  EXPECT_EQ(ActualSet.find(0), ActualSet.end());
+  EXPECT_EQ(ActualSet.find(6), ActualSet.end());
+  EXPECT_EQ(*ActualSet.lower_bound(0), 1);
+  EXPECT_EQ(*ActualSet.lower_bound(3), 3);
+  EXPECT_EQ(ActualSet.lower_bound(6), ActualSet.end());
+  EXPECT_EQ(*ActualSet.upper_bound(3), 4);
+  EXPECT_EQ(ActualSet.upper_bound(5), ActualSet.end());
+  auto [first, last] = ActualSet.equal_range(3);
+  EXPECT_EQ(*first, 3);
+  EXPECT_EQ(*last, 4);
+  auto [missing, missing_end] = ActualSet.equal_range(6);
+  EXPECT_EQ(missing, missing_end);
+  EXPECT_EQ(ActualSet.begin()->key_, 1);
+  EXPECT_EQ(*--ActualSet.end(), 5);
+  EXPECT_EQ(*ActualSet.rbegin(), 5);
+}
+
+TYPED_TEST(OrderedSetTest, EraseByKey) {
+  TypeParam ActualSet = {1, 2, 3, 4, 5};
+  EXPECT_EQ(ActualSet.erase(3), 1U);
+  EXPECT_EQ(ActualSet.erase(3), 0U);
+  EXPECT_EQ(ActualSet.erase(9), 0U);
+  EXPECT_FALSE(ActualSet.contains(3));
+  this->CompareSets(ActualSet, std::set<int>{1, 2, 4, 5});
+
+  EXPECT_EQ(*ActualSet.erase(ActualSet.find(1)), 2);
+  this->CompareSets(ActualSet, std::set<int>{2, 4, 5});
+}
+
+TYPED_TEST(OrderedSetTest, EraseRangeAndSwap) {
+  TypeParam ActualSet = {1, 2, 3, 4, 5, 6};
+  // The range result is stored first: end() is only known after the erase
+  auto it = ActualSet.erase(ActualSet.find(2), ActualSet.find(5));
+  EXPECT_EQ(*it, 5);
+  this->CompareSets(ActualSet, std::set<int>{1, 5, 6});
+  it = ActualSet.erase(ActualSet.find(5), ActualSet.end());
+  EXPECT_EQ(it, ActualSet.end());
+  this->CompareSets(ActualSet, std::set<int>{1});
+
+  TypeParam Other = {7, 8};
+  ActualSet.swap(Other);
+  this->CompareSets(ActualSet, std::set<int>{7, 8});
+  this->CompareSets(Other, std::set<int>{1});
+}
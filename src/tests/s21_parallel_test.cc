@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "components/s21_map.h"
+#include "s21_containersplus.h"
+
+TEST(ParallelTest, ForEachVisitsEveryEntryOnce) {
+  s21::set<int> ActualSet;
+  for (int i = 0; i < 100000; ++i) ActualSet.insert(i * 3);
+
+  for (unsigned threads : {1U, 2U, 5U, 0U}) {
+    std::vector<std::atomic<int>> seen(100000);
+    std::atomic<long long> sum{0};
+    s21::parallel_for_each(
+        ActualSet,
+        [&seen, &sum](const auto &entry) {
+          ++seen[entry.key_ / 3];
+          sum += entry.key_;
+        },
+        threads);
+    EXPECT_EQ(sum, 3LL * 99999 * 100000 / 2);
+    for (const auto &count : seen) ASSERT_EQ(count, 1);
+  }
+}
+
+TEST(ParallelTest, SlicesKeepKeyOrder) {
+  s21::map<int, int> ActualMap;
+  for (int i = 0; i < 50000; ++i) ActualMap[i] = 2 * i;
+
+  std::atomic<bool> ordered{true};
+  std::atomic<int> visited{0};
+  s21::parallel_for_each(
+      ActualMap,
+      [&ordered, &visited](const auto &entry) {
+        thread_local int previous = -1;
+        if (entry.key_ <= previous || entry.value_ != 2 * entry.key_) {
+          ordered = false;
+        }
+        previous = entry.key_;
+        ++visited;
+      },
+      4);
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(visited, 50000);
+}
+
+TEST(ParallelTest, ReduceIsOrdered) {
+  s21::map<int, std::string> ActualMap;
+  std::string expected;
+  for (int i = 0; i < 20000; ++i) {
+    ActualMap[i] = std::string(1, static_cast<char>('a' + i % 26));
+    expected += ActualMap[i];
+  }
+
+  // Concatenation is associative but not commutative
+  auto concat = [](std::string left, const std::string &right) {
+    return left + right;
+  };
+  for (unsigned threads : {1U, 3U, 8U}) {
+    std::string actual = s21::parallel_reduce(
+        ActualMap, std::string(">"),
+        [](const auto &entry) { return entry.value_; }, concat, threads);
+    EXPECT_EQ(actual, ">" + expected);
+  }
+
+  s21::map<int, std::string> Empty;
+  EXPECT_EQ(s21::parallel_reduce(
+                Empty, std::string("init"),
+                [](const auto &entry) { return entry.value_; }, concat),
+            "init");
+}
+
+TEST(ParallelTest, ReduceMultisetAndRethrow) {
+  s21::multiset<int> ActualSet;
+  for (int i = 0; i < 30000; ++i) ActualSet.insert(i % 100);
+  long long total = s21::parallel_reduce(
+      ActualSet, 0LL, [](const auto &entry) { return entry.key_; },
+      [](long long left, long long right) { return left + right; }, 4);
+  EXPECT_EQ(total, 300LL * 4950);
+
+  EXPECT_THROW(s21::parallel_for_each(
+                   ActualSet,
+                   [](const auto &entry) {
+                     if (entry.key_ == 99) throw std::runtime_error("99");
+                   },
+                   4),
+               std::runtime_error);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "s21_containersplus.h"
+
+template <typename Key, typename Value>
+void ComparePersistentMaps(const s21::persistent_map<Key, Value> &ActualMap,
+                           const std::map<Key, Value> &ExpectedMap) {
+  ASSERT_EQ(ActualMap.size(), ExpectedMap.size());
+  auto expected = ExpectedMap.begin();
+  for (auto it = ActualMap.begin(); it != ActualMap.end(); ++it, ++expected) {
+    ASSERT_EQ(*it, expected->first);
+    ASSERT_EQ(it->value_, expected->second);
+  }
+}
+
+TEST(PersistentMapTest, Basics) {
+  s21::persistent_map<int, std::string> ActualMap = {{2, "two"}, {1, "one"}};
+  EXPECT_EQ(ActualMap.size(), 2U);
+  EXPECT_EQ(ActualMap.at(2), "two");
+  EXPECT_THROW(ActualMap.at(3), std::out_of_range);
+  EXPECT_FALSE(ActualMap.insert({1, "uno"}));
+  EXPECT_EQ(ActualMap.at(1), "one");
+  EXPECT_FALSE(ActualMap.insert_or_assign(1, "uno"));
+  EXPECT_EQ(ActualMap.at(1), "uno");
+  EXPECT_TRUE(ActualMap.insert_or_assign(3, "three"));
+
+  auto it = ActualMap.find(2);
+  EXPECT_EQ(it->value_, "two");
+  EXPECT_EQ(*++it, 3);
+  EXPECT_EQ(++it, ActualMap.end());
+  EXPECT_EQ(ActualMap.find(7), ActualMap.end());
+
+  EXPECT_EQ(ActualMap.erase(2), 1U);
+  EXPECT_EQ(ActualMap.erase(2), 0U);
+  EXPECT_FALSE(ActualMap.contains(2));
+  ActualMap.clear();
+  EXPECT_TRUE(ActualMap.empty());
+  EXPECT_EQ(ActualMap.begin(), ActualMap.end());
+}
+
+TEST(PersistentMapTest, RandomMatchesStdMap) {
+  std::mt19937 gen(21);
+  s21::persistent_map<int, int> ActualMap;
+  std::map<int, int> ExpectedMap;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 2000);
+    switch (gen() % 3) {
+      case 0:
+        ASSERT_EQ(ActualMap.insert({key, i}),
+                  ExpectedMap.insert({key, i}).second);
+        break;
+      case 1:
+        ASSERT_EQ(ActualMap.insert_or_assign(key, i),
+                  ExpectedMap.insert_or_assign(key, i).second);
+        break;
+      default:
+        ASSERT_EQ(ActualMap.erase(key), ExpectedMap.erase(key));
+    }
+  }
+  ComparePersistentMaps(ActualMap, ExpectedMap);
+  for (int key = 0; key < 2000; ++key) {
+    ASSERT_EQ(ActualMap.contains(key), ExpectedMap.count(key) == 1);
+  }
+}
+
+TEST(PersistentMapTest, SnapshotsKeepTheirVersion) {
+  s21::persistent_map<int, int> ActualMap;
+  std::vector<s21::persistent_map<int, int>> versions;
+  std::vector<std::map<int, int>> expected;
+  std::map<int, int> ExpectedMap;
+  for (int i = 0; i < 300; ++i) {
+    if (i % 4 == 3) {
+      ActualMap.erase(i / 2);
+      ExpectedMap.erase(i / 2);
+    } else {
+      ActualMap.insert_or_assign(i % 100, i);
+      ExpectedMap[i % 100] = i;
+    }
+    versions.push_back(ActualMap.snapshot());
+    expected.push_back(ExpectedMap);
+  }
+  for (size_t i = 0; i < versions.size(); ++i) {
+    ComparePersistentMaps(versions[i], expected[i]);
+  }
+
+  // Dropping versions frees only the nodes nobody else uses
+  versions.erase(versions.begin(), versions.begin() + 150);
+  ActualMap.clear();
+  ComparePersistentMaps(versions.back(), expected.back());
+}
+
+// One writer keeps every value equal to the version number while readers
+// take snapshots: a snapshot must never mix two versions
+TEST(PersistentMapTest, ReadersSeeConsistentSnapshots) {
+  s21::persistent_map<int, int> ActualMap;
+  for (int key = 0; key < 64; ++key) ActualMap.insert({key, 0});
+
+  std::atomic<bool> done{false};
+  std::atomic<bool> consistent{true};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&ActualMap, &done, &consistent] {
+      while (!done) {
+        auto snapshot = ActualMap.snapshot();
+        int version = snapshot.at(0);
+        for (auto it = snapshot.begin(); it != snapshot.end(); ++it) {
+          if (it->value_ != version) consistent = false;
+        }
+        if (snapshot.size() != 64) consistent = false;
+      }
+    });
+  }
+  for (int version = 1; version <= 200; ++version) {
+    s21::persistent_map<int, int> next = ActualMap.snapshot();
+    for (int key = 0; key < 64; ++key) next.insert_or_assign(key, version);
+    ActualMap = next;
+  }
+  done = true;
+  for (auto &reader : readers) reader.join();
+  EXPECT_TRUE(consistent);
+  EXPECT_EQ(ActualMap.at(63), 200);
+}
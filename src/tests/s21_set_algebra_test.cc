@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "s21_containersplus.h"
+
+namespace {
+
+std::set<int> RandomStdSet(std::mt19937 &gen, int count, int range) {
+  std::set<int> keys;
+  for (int i = 0; i < count; ++i) keys.insert(static_cast<int>(gen() % range));
+  return keys;
+}
+
+template <typename Set>
+std::vector<int> Keys(const Set &set) {
+  return std::vector<int>(set.begin(), set.end());
+}
+
+struct Expected {
+  std::vector<int> united, common, left_only, exclusive;
+
+  Expected(const std::set<int> &left, const std::set<int> &right) {
+    std::set_union(left.begin(), left.end(), right.begin(), right.end(),
+                   std::back_inserter(united));
+    std::set_intersection(left.begin(), left.end(), right.begin(),
+                          right.end(), std::back_inserter(common));
+    std::set_difference(left.begin(), left.end(), right.begin(), right.end(),
+                        std::back_inserter(left_only));
+    std::set_symmetric_difference(left.begin(), left.end(), right.begin(),
+                                  right.end(), std::back_inserter(exclusive));
+  }
+};
+
+}  // namespace
+
+TEST(SetAlgebraTest, MatchesStdAlgorithms) {
+  std::mt19937 gen(22);
+  // Equal sizes merge-walk, very different sizes probe with a finger
+  for (auto [left_count, right_count] :
+       {std::pair{3000, 3000}, {100, 20000}, {20000, 100}, {0, 500}}) {
+    std::set<int> left = RandomStdSet(gen, left_count, 40000);
+    std::set<int> right = RandomStdSet(gen, right_count, 40000);
+    s21::set<int> Left(left.begin(), left.end());
+    s21::set<int> Right(right.begin(), right.end());
+    Expected expected(left, right);
+
+    EXPECT_EQ(Keys(s21::set_union(Left, Right)), expected.united);
+    EXPECT_EQ(Keys(s21::set_intersection(Left, Right)), expected.common);
+    EXPECT_EQ(Keys(s21::set_difference(Left, Right)), expected.left_only);
+    EXPECT_EQ(Keys(s21::set_symmetric_difference(Left, Right)),
+              expected.exclusive);
+
+    for (unsigned threads : {1U, 3U}) {
+      EXPECT_EQ(Keys(s21::parallel_set_union(Left, Right, threads)),
+                expected.united);
+      EXPECT_EQ(Keys(s21::parallel_set_intersection(Left, Right, threads)),
+                expected.common);
+      EXPECT_EQ(Keys(s21::parallel_set_difference(Left, Right, threads)),
+                expected.left_only);
+      EXPECT_EQ(
+          Keys(s21::parallel_set_symmetric_difference(Left, Right, threads)),
+          expected.exclusive);
+    }
+  }
+}
+
+TEST(SetAlgebraTest, ParallelOnLargeSets) {
+  std::mt19937 gen(23);
+  std::set<int> left = RandomStdSet(gen, 60000, 200000);
+  std::set<int> right = RandomStdSet(gen, 40000, 200000);
+  s21::set<int> Left(left.begin(), left.end());
+  s21::set<int> Right(right.begin(), right.end());
+  Expected expected(left, right);
+
+  EXPECT_EQ(Keys(s21::parallel_set_union(Left, Right, 4)), expected.united);
+  EXPECT_EQ(Keys(s21::parallel_set_intersection(Right, Left, 4)),
+            expected.common);
+  EXPECT_EQ(Keys(s21::parallel_set_difference(Left, Right, 4)),
+            expected.left_only);
+  EXPECT_EQ(Keys(s21::parallel_set_symmetric_difference(Left, Right, 4)),
+            expected.exclusive);
+}
+
+TEST(SetAlgebraTest, InPlace) {
+  std::mt19937 gen(24);
+  std::set<int> left = RandomStdSet(gen, 5000, 20000);
+  std::set<int> right = RandomStdSet(gen, 5000, 20000);
+  Expected expected(left, right);
+
+  s21::set<int> Left(left.begin(), left.end());
+  s21::set<int> Right(right.begin(), right.end());
+  Left.intersect(Right);
+  EXPECT_EQ(Keys(Left), expected.common);
+  EXPECT_EQ(Right.size(), right.size());
+
+  Left = s21::set<int>(left.begin(), left.end());
+  Left.subtract(Right);
+  EXPECT_EQ(Keys(Left), expected.left_only);
+
+  Left = s21::set<int>(left.begin(), left.end());
+  Left.unite(Right);
+  EXPECT_EQ(Keys(Left), expected.united);
+  EXPECT_TRUE(Right.empty());
+
+  Left = s21::set<int>(left.begin(), left.end());
+  Right = s21::set<int>(right.begin(), right.end());
+  Left.toggle(Right);
+  EXPECT_EQ(Keys(Left), expected.exclusive);
+  EXPECT_TRUE(Right.empty());
+  EXPECT_EQ(*Left.nth(100), expected.exclusive[100]);
+
+  Left.intersect(Left);
+  EXPECT_EQ(Keys(Left), expected.exclusive);
+  Left.subtract(Left);
+  EXPECT_TRUE(Left.empty());
+}
+
+TEST(SetAlgebraTest, PoolStorageAndStrings) {
+  using PoolSet =
+      s21::set<std::string, std::less<std::string>, s21::PoolStorage>;
+  PoolSet Left = {"apple", "kiwi", "pear", "plum"};
+  PoolSet Right = {"fig", "kiwi", "plum", "quince"};
+
+  PoolSet Common = s21::set_intersection(Left, Right);
+  EXPECT_EQ(std::vector<std::string>(Common.begin(), Common.end()),
+            (std::vector<std::string>{"kiwi", "plum"}));
+
+  Left.toggle(Right);
+  EXPECT_EQ(std::vector<std::string>(Left.begin(), Left.end()),
+            (std::vector<std::string>{"apple", "fig", "pear", "quince"}));
+  EXPECT_TRUE(Right.empty());
+  Right.insert("zzz");
+  Left.unite(Right);
+  EXPECT_EQ(Left.size(), 5U);
+  EXPECT_EQ(*Left.rbegin(), "zzz");
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "s21_containersplus.h"
+
+template <typename T, std::size_t N>
+void CompareSmallSets(const s21::small_set<T, N> &ActualSet,
+                      const std::set<T> &ExpectedSet) {
+  ASSERT_EQ(ActualSet.size(), ExpectedSet.size());
+  EXPECT_TRUE(std::equal(ActualSet.begin(), ActualSet.end(),
+                         ExpectedSet.begin(), ExpectedSet.end()));
+}
+
+TEST(SmallSetTest, StaysInlineUpToN) {
+  s21::small_set<int, 4> ActualSet = {3, 1, 3, 2};
+  EXPECT_TRUE(ActualSet.is_inline());
+  EXPECT_EQ(ActualSet.size(), 3U);
+  EXPECT_EQ(*ActualSet.begin(), 1);
+  EXPECT_FALSE(ActualSet.insert(2).second);
+
+  auto [it, inserted] = ActualSet.insert(0);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*it, 0);
+  EXPECT_TRUE(ActualSet.is_inline());
+  CompareSmallSets(ActualSet, std::set<int>{0, 1, 2, 3});
+}
+
+TEST(SmallSetTest, SpillsToTreeAndBack) {
+  s21::small_set<int, 4> ActualSet = {4, 2, 3, 1};
+  auto [it, inserted] = ActualSet.insert(5);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*it, 5);
+  EXPECT_FALSE(ActualSet.is_inline());
+  CompareSmallSets(ActualSet, std::set<int>{1, 2, 3, 4, 5});
+  EXPECT_EQ(*--ActualSet.end(), 5);
+
+  ActualSet.clear();
+  EXPECT_TRUE(ActualSet.is_inline());
+  EXPECT_TRUE(ActualSet.empty());
+  ActualSet.insert(7);
+  EXPECT_EQ(*ActualSet.begin(), 7);
+}
+
+TEST(SmallSetTest, RandomMatchesStdSet) {
+  std::mt19937 gen(18);
+  for (int round = 0; round < 200; ++round) {
+    s21::small_set<int, 8> ActualSet;
+    std::set<int> ExpectedSet;
+    for (int i = 0; i < 40; ++i) {
+      int key = static_cast<int>(gen() % 16);
+      if (gen() % 3 == 0) {
+        ASSERT_EQ(ActualSet.erase(key), ExpectedSet.erase(key));
+      } else {
+        ASSERT_EQ(ActualSet.insert(key).second,
+                  ExpectedSet.insert(key).second);
+      }
+      ASSERT_EQ(ActualSet.contains(key), ExpectedSet.count(key) == 1);
+      auto bound = ActualSet.lower_bound(key);
+      auto expected = ExpectedSet.lower_bound(key);
+      ASSERT_EQ(bound == ActualSet.end(), expected == ExpectedSet.end());
+      if (expected != ExpectedSet.end()) {
+        ASSERT_EQ(*bound, *expected);
+      }
+    }
+    CompareSmallSets(ActualSet, ExpectedSet);
+  }
+}
+
+TEST(SmallSetTest, CopyAndMove) {
+  s21::small_set<std::string, 2> Inline = {"b", "a"};
+  s21::small_set<std::string, 2> Spilled = {"c", "b", "a"};
+
+  for (auto *source : {&Inline, &Spilled}) {
+    s21::small_set<std::string, 2> Copy(*source);
+    EXPECT_TRUE(std::equal(Copy.begin(), Copy.end(), source->begin(),
+                           source->end()));
+    s21::small_set<std::string, 2> Moved(std::move(Copy));
+    EXPECT_TRUE(Copy.empty());
+    EXPECT_EQ(Moved.size(), source->size());
+    EXPECT_EQ(*Moved.begin(), "a");
+
+    s21::small_set<std::string, 2> Assigned = {"z"};
+    Assigned = Moved;
+    EXPECT_EQ(Assigned.size(), source->size());
+    Assigned = std::move(Moved);
+    EXPECT_EQ(Assigned.is_inline(), source->is_inline());
+  }
+}
+
+TEST(SmallMapTest, InlineAndSpilled) {
+  s21::small_map<int, std::string, 3> ActualMap = {{2, "two"}, {1, "one"}};
+  ActualMap[3] = "three";
+  EXPECT_TRUE(ActualMap.is_inline());
+  EXPECT_EQ(ActualMap.at(2), "two");
+  EXPECT_EQ(ActualMap.begin()->value_, "one");
+  EXPECT_THROW(ActualMap.at(4), std::out_of_range);
+
+  EXPECT_FALSE(ActualMap.insert({1, "uno"}).second);
+  EXPECT_EQ(ActualMap.at(1), "one");
+  ActualMap.insert_or_assign(1, "uno");
+  EXPECT_EQ(ActualMap.at(1), "uno");
+
+  ActualMap.try_emplace(4, 3, 'x');
+  EXPECT_FALSE(ActualMap.is_inline());
+  EXPECT_EQ(ActualMap.at(4), "xxx");
+  EXPECT_EQ(ActualMap.at(3), "three");
+  ActualMap[3] += "!";
+  EXPECT_EQ(ActualMap.find(3)->value_, "three!");
+
+  std::map<int, std::string> ExpectedMap = {
+      {1, "uno"}, {2, "two"}, {3, "three!"}, {4, "xxx"}};
+  auto expected = ExpectedMap.begin();
+  for (auto it = ActualMap.begin(); it != ActualMap.end(); ++it, ++expected) {
+    EXPECT_EQ(*it, expected->first);
+    EXPECT_EQ(it->value_, expected->second);
+  }
+  EXPECT_EQ(ActualMap.erase(2), 1U);
+  EXPECT_FALSE(ActualMap.contains(2));
+}
+
+// Keys past the small string buffer, so every shift really moves them
+TEST(SmallMapTest, StringKeys) {
+  s21::small_map<std::string, int, 4> ActualMap;
+  std::map<std::string, int> ExpectedMap;
+  for (int i : {3, 1, 4, 0, 2, 5}) {
+    std::string key(32, static_cast<char>('a' + i));
+    ActualMap[key] = i;
+    ExpectedMap[key] = i;
+    if (i == 4) {
+      ActualMap.erase(std::string(32, 'c'));
+      ExpectedMap.erase(std::string(32, 'c'));
+    }
+  }
+  EXPECT_FALSE(ActualMap.is_inline());
+  ASSERT_EQ(ActualMap.size(), ExpectedMap.size());
+  auto expected = ExpectedMap.begin();
+  for (auto it = ActualMap.begin(); it != ActualMap.end(); ++it, ++expected) {
+    EXPECT_EQ(*it, expected->first);
+    EXPECT_EQ(it->value_, expected->second);
+  }
+}
+
+// Its copy constructor throws once copies_left runs out, moves never do
+struct FragileKey {
+  static inline int copies_left = 0;
+  int value = 0;
+
+  FragileKey(int v) : value(v) {}
+  FragileKey(const FragileKey &other) : value(other.value) {
+    if (copies_left-- == 0) throw std::runtime_error("copy");
+  }
+  FragileKey(FragileKey &&other) noexcept = default;
+  FragileKey &operator=(const FragileKey &other) = default;
+  FragileKey &operator=(FragileKey &&other) noexcept = default;
+  bool operator<(const FragileKey &other) const { return value < other.value; }
+};
+
+TEST(SmallMapTest, FailedSpillKeepsValues) {
+  std::string one(32, '1');
+  std::string two(32, '2');
+  FragileKey::copies_left = 100;
+  s21::small_map<FragileKey, std::string, 2> ActualMap;
+  ActualMap.try_emplace(1, one);
+  ActualMap.try_emplace(2, two);
+
+  // The tree copies the first key, then fails on the second
+  FragileKey::copies_left = 1;
+  EXPECT_THROW(ActualMap.try_emplace(3, "three"), std::runtime_error);
+  FragileKey::copies_left = 100;
+  EXPECT_TRUE(ActualMap.is_inline());
+  ASSERT_EQ(ActualMap.size(), 2U);
+  EXPECT_EQ(ActualMap.at(1), one);
+  EXPECT_EQ(ActualMap.at(2), two);
+
+  EXPECT_TRUE(ActualMap.try_emplace(3, "three").second);
+  EXPECT_FALSE(ActualMap.is_inline());
+  EXPECT_EQ(ActualMap.at(1), one);
+}
+
+TEST(SmallSetTest, RangeEraseAndSwapAcrossModes) {
+  s21::small_set<std::string, 2> Inline = {"b", "a"};
+  s21::small_set<std::string, 2> Spilled = {"d", "c", "b", "a"};
+  Inline.swap(Spilled);
+  EXPECT_FALSE(Inline.is_inline());
+  EXPECT_TRUE(Spilled.is_inline());
+  EXPECT_EQ(*Inline.rbegin(), "d");
+  EXPECT_EQ(*Spilled.rbegin(), "b");
+
+  auto it = Inline.erase(Inline.find("b"), Inline.find("d"));
+  EXPECT_EQ(*it, "d");
+  CompareSmallSets(Inline, std::set<std::string>{"a", "d"});
+  EXPECT_EQ(*Inline.upper_bound("a"), "d");
+
+  it = Spilled.erase(Spilled.begin(), Spilled.end());
+  EXPECT_EQ(it, Spilled.end());
+  EXPECT_TRUE(Spilled.empty());
+}
+
+TEST(SmallMapTest, InsertKeyAndValue) {
+  s21::small_map<int, std::string, 2> ActualMap;
+  EXPECT_TRUE(ActualMap.insert(2, "two").second);
+  EXPECT_FALSE(ActualMap.insert(2, "zwei").second);
+  EXPECT_TRUE(ActualMap.insert(1, "one").second);
+  EXPECT_TRUE(ActualMap.insert(3, "three").second);
+  EXPECT_FALSE(ActualMap.is_inline());
+  EXPECT_EQ(ActualMap.at(2), "two");
+  auto [first, last] = ActualMap.equal_range(3);
+  EXPECT_EQ(first->value_, "three");
+  EXPECT_EQ(last, ActualMap.end());
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "s21_containersplus.h"
+
+template <typename Set>
+std::set<int> Collect(const Set &set) {
+  std::set<int> keys;
+  for (auto it = set.begin(); it != set.end(); ++it) {
+    EXPECT_TRUE(keys.insert(*it).second) << "visited twice: " << *it;
+  }
+  return keys;
+}
+
+// Hashes std::string, std::string_view and string literals alike
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view text) const {
+    return std::hash<std::string_view>()(text);
+  }
+};
+
+// Every key collides, so every lookup walks the whole probe sequence
+struct ConstantHash {
+  std::size_t operator()(int) const { return 0; }
+};
+
+TEST(UnorderedSetTest, InsertFindErase) {
+  s21::unordered_set<int> ActualSet = {5, 1, 4, 1, 3};
+  EXPECT_EQ(ActualSet.size(), 4U);
+  EXPECT_FALSE(ActualSet.insert(4).second);
+  auto [it, inserted] = ActualSet.insert(2);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*it, 2);
+  EXPECT_TRUE(ActualSet.contains(3));
+  EXPECT_EQ(ActualSet.count(6), 0U);
+  EXPECT_EQ(ActualSet.find(6), ActualSet.end());
+  EXPECT_EQ(ActualSet.find(5)->key_, 5);
+  EXPECT_EQ(ActualSet.erase(3), 1U);
+  EXPECT_EQ(ActualSet.erase(3), 0U);
+  EXPECT_EQ(Collect(ActualSet), (std::set<int>{1, 2, 4, 5}));
+
+  ActualSet.clear();
+  EXPECT_TRUE(ActualSet.empty());
+  EXPECT_EQ(ActualSet.begin(), ActualSet.end());
+  ActualSet.insert(7);
+  EXPECT_EQ(*ActualSet.begin(), 7);
+}
+
+TEST(UnorderedSetTest, RandomMatchesStdUnorderedSet) {
+  std::mt19937 gen(25);
+  s21::unordered_set<int> ActualSet;
+  std::unordered_set<int> ExpectedSet;
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(gen() % 20000);
+    if (gen() % 4 == 0) {
+      ASSERT_EQ(ActualSet.erase(key), ExpectedSet.erase(key));
+    } else {
+      ASSERT_EQ(ActualSet.insert(key).second,
+                ExpectedSet.insert(key).second);
+    }
+    ASSERT_EQ(ActualSet.size(), ExpectedSet.size());
+    // Also checked while a growth is half way through its migration
+    if (i % 997 == 0) {
+      ASSERT_EQ(Collect(ActualSet),
+                std::set<int>(ExpectedSet.begin(), ExpectedSet.end()));
+    }
+  }
+  for (int key = -1; key <= 20000; ++key) {
+    ASSERT_EQ(ActualSet.contains(key), ExpectedSet.count(key) == 1);
+  }
+  EXPECT_LE(ActualSet.load_factor(), ActualSet.max_load_factor());
+}
+
+TEST(UnorderedSetTest, GrowthVisitsEveryKeyOnce) {
+  s21::unordered_set<int> ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 3000; ++i) {
+    ActualSet.insert(i * 1024);
+    ExpectedSet.insert(i * 1024);
+    if (i % 61 == 0) {
+      ASSERT_EQ(Collect(ActualSet), ExpectedSet);
+    }
+  }
+  for (int i = 0; i < 3000; ++i) ASSERT_TRUE(ActualSet.contains(i * 1024));
+}
+
+TEST(UnorderedSetTest, EraseWhileIterating) {
+  s21::unordered_set<int> ActualSet;
+  for (int i = 0; i < 1000; ++i) ActualSet.insert(i);
+  for (auto it = ActualSet.begin(); it != ActualSet.end();) {
+    it = *it % 2 == 0 ? ActualSet.erase(it) : std::next(it);
+  }
+  EXPECT_EQ(ActualSet.size(), 500U);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(ActualSet.contains(i), i % 2 == 1);
+  }
+}
+
+TEST(UnorderedSetTest, TombstonesAreReclaimed) {
+  s21::unordered_set<int> ActualSet;
+  ActualSet.reserve(100);
+  std::size_t buckets = ActualSet.bucket_count();
+  for (int round = 0; round < 100; ++round) {
+    for (int i = 0; i < 100; ++i) ActualSet.insert(round * 100 + i);
+    for (int i = 0; i < 100; ++i) ActualSet.erase(round * 100 + i);
+  }
+  EXPECT_TRUE(ActualSet.empty());
+  EXPECT_EQ(ActualSet.bucket_count(), buckets);
+}
+
+TEST(UnorderedSetTest, ReserveAndLoadFactor) {
+  s21::unordered_set<int> ActualSet(1000);
+  std::size_t buckets = ActualSet.bucket_count();
+  EXPECT_GE(buckets * ActualSet.max_load_factor(), 1000.0f);
+  for (int i = 0; i < 1000; ++i) ActualSet.insert(i);
+  EXPECT_EQ(ActualSet.bucket_count(), buckets);
+
+  ActualSet.max_load_factor(2.0f);
+  EXPECT_LT(ActualSet.max_load_factor(), 1.0f);
+  ActualSet.max_load_factor(0.25f);
+  ActualSet.insert(1000);
+  EXPECT_GT(ActualSet.bucket_count(), buckets);
+  ActualSet.reserve(0);
+  EXPECT_LE(ActualSet.load_factor(), 0.25f);
+  EXPECT_EQ(ActualSet.size(), 1001U);
+}
+
+TEST(UnorderedSetTest, HeterogeneousLookup) {
+  s21::unordered_set<std::string, StringHash, std::equal_to<>> ActualSet = {
+      "alpha", "beta"};
+  std::string_view view = "beta";
+  EXPECT_TRUE(ActualSet.contains(view));
+  EXPECT_EQ(*ActualSet.find("alpha"), "alpha");
+  EXPECT_EQ(ActualSet.count("gamma"), 0U);
+  EXPECT_EQ(ActualSet.find(std::string("beta"))->key_, "beta");
+}
+
+TEST(UnorderedSetTest, CollidingHash) {
+  s21::unordered_set<int, ConstantHash> ActualSet;
+  for (int i = 0; i < 300; ++i) ActualSet.insert(i);
+  for (int i = 0; i < 300; i += 2) ActualSet.erase(i);
+  for (int i = -1; i < 300; ++i) {
+    ASSERT_EQ(ActualSet.contains(i), i >= 0 && i % 2 == 1);
+  }
+  EXPECT_EQ(ActualSet.size(), 150U);
+}
+
+TEST(UnorderedSetTest, CopyAndMove) {
+  s21::unordered_set<std::string> Original;
+  for (int i = 0; i < 500; ++i) Original.insert(std::to_string(i));
+  s21::unordered_set<std::string> Copy(Original);
+  Copy.erase("0");
+  EXPECT_EQ(Original.size(), 500U);
+  EXPECT_EQ(Copy.size(), 499U);
+  s21::unordered_set<std::string> Moved(std::move(Copy));
+  EXPECT_TRUE(Copy.empty());
+  Copy = Moved;
+  Moved = std::move(Original);
+  EXPECT_TRUE(Moved.contains("0"));
+  EXPECT_FALSE(Copy.contains("0"));
+  EXPECT_TRUE(Copy.contains("499"));
+}
+
+TEST(UnorderedMapTest, MapInterface) {
+  s21::unordered_map<int, std::string> ActualMap = {{2, "two"}, {1, "one"}};
+  EXPECT_EQ(ActualMap.at(2), "two");
+  EXPECT_THROW(ActualMap.at(3), std::out_of_range);
+  ActualMap[3] = "three";
+  EXPECT_FALSE(ActualMap.insert(3, "drei").second);
+  EXPECT_FALSE(ActualMap.insert_or_assign(3, "drei").second);
+  EXPECT_TRUE(ActualMap.try_emplace(4, 3, 'x').second);
+  EXPECT_EQ(ActualMap.find(3)->value_, "drei");
+  EXPECT_EQ(ActualMap.find(4)->value_, "xxx");
+  EXPECT_EQ(*ActualMap.find(1), 1);
+  EXPECT_EQ(ActualMap.size(), 4U);
+}
+
+TEST(UnorderedMapTest, RandomMatchesStdUnorderedMap) {
+  std::mt19937 gen(52);
+  s21::unordered_map<std::string, int> ActualMap;
+  std::unordered_map<std::string, int> ExpectedMap;
+  for (int i = 0; i < 30000; ++i) {
+    std::string key = "key" + std::to_string(gen() % 5000);
+    if (gen() % 3 == 0) {
+      ASSERT_EQ(ActualMap.erase(key), ExpectedMap.erase(key));
+    } else {
+      ActualMap[key] += i;
+      ExpectedMap[key] += i;
+    }
+  }
+  ASSERT_EQ(ActualMap.size(), ExpectedMap.size());
+  for (auto it = ActualMap.begin(); it != ActualMap.end(); ++it) {
+    ASSERT_EQ(it->value_, ExpectedMap.at(*it));
+  }
+}
@@ -2,14 +2,25 @@
 #include "components/s21_set.h"
 // 2) C system headers
 // 3) C++ standard library headers
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <map>
+#include <numeric>
+#include <random>
 #include <set>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
 // 4) other libraries' headers
 #include <gtest/gtest.h>
 // 5) project's headers.
+#include "components/s21_map.h"
 
-template <typename T>
-void CompareSets(s21::set<T> &ActualSet, std::set<T> &ExpectedSet) {
+template <typename T, typename Compare, template <typename> class Storage>
+void CompareSets(s21::set<T, Compare, Storage> &ActualSet,
+                 std::set<T> &ExpectedSet) {
   EXPECT_EQ(ExpectedSet.size(), ActualSet.size());
 
   for (auto it = ActualSet.begin(), it2 = ExpectedSet.begin();
@@ -20,6 +31,100 @@ void CompareSets(s21::set<T> &ActualSet, std::set<T> &ExpectedSet) {
   EXPECT_EQ(ActualSet.empty(), ExpectedSet.empty());
 }
 
+// Exposes the red-black, subtree-count and cached-ends invariants to the
+// tests
+template <template <typename> class Storage>
+class BasicCheckedSet : public s21::set<int, std::less<int>, Storage> {
+ public:
+  using s21::set<int, std::less<int>, Storage>::set;
+  using typename s21::set<int, std::less<int>, Storage>::Node;
+
+  bool IsValidTree() const {
+    Node *root = this->root_;
+    bool ends_cached =
+        root ? this->header_.leftmost_ == Minimum(root) &&
+                   this->header_.rightmost_ == Maximum(root)
+             : !this->header_.leftmost_ && !this->header_.rightmost_;
+    return ends_cached && IsBlack(root) && BlackHeight(root) >= 0;
+  }
+
+ private:
+  // Returns -1 if a red node has a red child, the black heights differ or a
+  // subtree count is stale
+  static int BlackHeight(const Node *node) {
+    if (node == nullptr) return 0;
+    if (IsRed(node) && (IsRed(node->left_) || IsRed(node->right_))) return -1;
+    if (node->count() != Count(node->left_) + Count(node->right_) + 1) {
+      return -1;
+    }
+    int left = BlackHeight(node->left_);
+    int right = BlackHeight(node->right_);
+    if (left < 0 || left != right) return -1;
+    return left + (IsBlack(node) ? 1 : 0);
+  }
+
+  using s21::set<int, std::less<int>, Storage>::Count;
+  using s21::set<int, std::less<int>, Storage>::IsBlack;
+  using s21::set<int, std::less<int>, Storage>::IsRed;
+  using s21::set<int, std::less<int>, Storage>::Maximum;
+  using s21::set<int, std::less<int>, Storage>::Minimum;
+};
+
+using CheckedSet = BasicCheckedSet<s21::HeapStorage>;
+using CheckedPoolSet = BasicCheckedSet<s21::PoolStorage>;
+using PoolStringSet =
+    s21::set<std::string, std::less<std::string>, s21::PoolStorage>;
+
+// Splay trees have no colour invariants, only the order, parent links,
+// subtree counts and cached ends are checked
+template <template <typename> class Storage>
+class BasicSplaySet
+    : public s21::set<int, std::less<int>, Storage, s21::SplayBalance> {
+  using Base = s21::set<int, std::less<int>, Storage, s21::SplayBalance>;
+
+ public:
+  using Base::Base;
+  using typename Base::Node;
+
+  bool IsValidTree() const {
+    Node *root = this->root_;
+    if (root == nullptr) {
+      return !this->header_.leftmost_ && !this->header_.rightmost_;
+    }
+    return root->parent_ == nullptr &&
+           this->header_.leftmost_ == Base::Minimum(root) &&
+           this->header_.rightmost_ == Base::Maximum(root) && IsValid(root);
+  }
+
+  const int *RootKey() const {
+    return this->root_ ? &this->root_->key_ : nullptr;
+  }
+
+ private:
+  static bool IsValid(const Node *node) {
+    if (node == nullptr) return true;
+    if (node->count() !=
+        Base::Count(node->left_) + Base::Count(node->right_) + 1) {
+      return false;
+    }
+    for (const Node *child : {node->left_, node->right_}) {
+      if (child && child->parent_ != node) return false;
+    }
+    if (node->left_ && !(Base::Maximum(node->left_)->key_ <
+                         node->key_)) {
+      return false;
+    }
+    if (node->right_ && !(node->key_ <
+                          Base::Minimum(node->right_)->key_)) {
+      return false;
+    }
+    return IsValid(node->left_) && IsValid(node->right_);
+  }
+};
+
+using SplaySet = BasicSplaySet<s21::HeapStorage>;
+using SplayPoolSet = BasicSplaySet<s21::PoolStorage>;
+
 // template <typename Key, typename Value>
 // void CompareMaps(s21::map<Key, Value> &ActualMap, std::map<Key, Value>
 // &ExpectedMap) {
@@ -38,7 +143,7 @@ TEST(SetTest, Iterators) {
   // 10 15 20 25 30 40 50 70 80 90
   s21::set<int> ActualSet = {50, 25, 10, 30, 60, 80, 15, 40, 70, 90, 20};
 
-  EXPECT_EQ(ActualSet.end(), nullptr);
+  EXPECT_EQ(*--ActualSet.end(), 90);
   auto it = ActualSet.begin();
   EXPECT_EQ(*it, 10);
   it++;
@@ -234,6 +339,1034 @@ TEST(SetTest, Contains) {
   EXPECT_FALSE(ActualSet.contains(-1));
 }
 
+TEST(SetTest, SortedInsertStaysBalanced) {
+  CheckedSet ActualSet;
+  std::set<int> ExpectedSet;
+
+  for (int i = 0; i < 200000; ++i) {
+    ActualSet.insert(i);
+    ExpectedSet.insert(i);
+  }
+
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  EXPECT_TRUE(ActualSet.contains(0));
+  EXPECT_TRUE(ActualSet.contains(199999));
+  EXPECT_FALSE(ActualSet.contains(200000));
+  CompareSets<int>(ActualSet, ExpectedSet);
+}
+
+TEST(SetTest, RandomInsertEraseStaysBalanced) {
+  CheckedSet ActualSet;
+  std::set<int> ExpectedSet;
+  std::mt19937 gen(21);
+  std::uniform_int_distribution<int> dist(0, 999);
+
+  for (int i = 0; i < 20000; ++i) {
+    int key = dist(gen);
+    if (i % 3 == 0 && ActualSet.contains(key)) {
+      ActualSet.erase(ActualSet.find(key));
+      ExpectedSet.erase(key);
+    } else {
+      ActualSet.insert(key);
+      ExpectedSet.insert(key);
+    }
+  }
+
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  CompareSets<int>(ActualSet, ExpectedSet);
+}
+
+TEST(SetTest, SizeTracksInsertAndErase) {
+  s21::set<int> ActualSet = {5, 3, 8, 1, 4};
+  EXPECT_EQ(ActualSet.size(), 5U);
+
+  ActualSet.insert(4);
+  EXPECT_EQ(ActualSet.size(), 5U);
+  ActualSet.insert(10);
+  EXPECT_EQ(ActualSet.size(), 6U);
+
+  ActualSet.erase(ActualSet.find(3));
+  ActualSet.erase(ActualSet.find(5));
+  EXPECT_EQ(ActualSet.size(), 4U);
+
+  s21::set<int> CopySet(ActualSet);
+  EXPECT_EQ(CopySet.size(), 4U);
+  ActualSet.clear();
+  EXPECT_EQ(ActualSet.size(), 0U);
+}
+
+TEST(SetTest, NthAndRank) {
+  CheckedSet ActualSet;
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> dist(0, 4999);
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 3000; ++i) {
+    int key = dist(gen);
+    ActualSet.insert(key);
+    ExpectedSet.insert(key);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    int key = dist(gen);
+    if (ActualSet.contains(key)) ActualSet.erase(ActualSet.find(key));
+    ExpectedSet.erase(key);
+  }
+
+  ASSERT_EQ(ActualSet.size(), ExpectedSet.size());
+  size_t k = 0;
+  for (int key : ExpectedSet) {
+    EXPECT_EQ(*ActualSet.nth(k), key);
+    EXPECT_EQ(ActualSet.rank(key), k);
+    ++k;
+  }
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  EXPECT_EQ(ActualSet.nth(ExpectedSet.size()), ActualSet.end());
+  EXPECT_EQ(ActualSet.rank(-1), 0U);
+  EXPECT_EQ(ActualSet.rank(5000), ExpectedSet.size());
+}
+
+TEST(SetTest, EraseKeepsOtherIteratorsValid) {
+  s21::set<int> ActualSet = {50, 25, 75, 10, 35, 60, 80, 30, 40};
+
+  // 60 is the in-order successor of 50 and moves into its place
+  auto successor = ActualSet.find(60);
+  auto leaf = ActualSet.find(30);
+  auto next = ActualSet.erase(ActualSet.find(50));
+
+  EXPECT_EQ(next, successor);
+  EXPECT_EQ(*successor, 60);
+  EXPECT_EQ(*leaf, 30);
+  ++leaf;
+  EXPECT_EQ(*leaf, 35);
+  ++successor;
+  EXPECT_EQ(*successor, 75);
+}
+
+TEST(SetTest, EraseReturnsNext) {
+  s21::set<int> ActualSet = {1, 2, 3, 4, 5, 6, 7, 8};
+
+  auto it = ActualSet.begin();
+  while (it != ActualSet.end()) {
+    it = *it % 2 == 0 ? ActualSet.erase(it) : ++it;
+  }
+
+  std::set<int> ExpectedSet = {1, 3, 5, 7};
+  CompareSets(ActualSet, ExpectedSet);
+}
+
+TEST(SetTest, ChurnKeepsTreeValid) {
+  CheckedSet ActualSet;
+  for (int i = 0; i < 1000; ++i) ActualSet.insert(i);
+
+  for (int i = 1000; i < 50000; ++i) {
+    ActualSet.insert(i);
+    ActualSet.erase(ActualSet.find(i - 1000));
+  }
+
+  EXPECT_EQ(ActualSet.size(), 1000U);
+  EXPECT_EQ(*ActualSet.begin(), 49000);
+  EXPECT_TRUE(ActualSet.IsValidTree());
+}
+
+TEST(SetTest, ReverseIteration) {
+  s21::set<int> ActualSet = {50, 25, 10, 30, 60, 80, 15, 40, 70, 90, 20};
+  std::set<int> ExpectedSet(ActualSet.begin(), ActualSet.end());
+
+  EXPECT_TRUE(std::equal(ActualSet.rbegin(), ActualSet.rend(),
+                         ExpectedSet.rbegin(), ExpectedSet.rend()));
+  auto it = ActualSet.end();
+  --it;
+  EXPECT_EQ(*it, 90);
+  --it;
+  EXPECT_EQ(*it, 80);
+  ++it;
+  ++it;
+  EXPECT_EQ(it, ActualSet.end());
+
+  s21::set<int> EmptySet;
+  EXPECT_EQ(EmptySet.begin(), EmptySet.end());
+  EXPECT_EQ(EmptySet.rbegin(), EmptySet.rend());
+}
+
+TEST(SetTest, EndsFollowInsertAndErase) {
+  std::mt19937 gen(9);
+  CheckedSet ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 2000);
+    if (gen() % 3 == 0) {
+      // Mostly take away the current ends
+      auto it = gen() % 2 ? ActualSet.begin() : --ActualSet.end();
+      if (it != ActualSet.end()) {
+        ExpectedSet.erase(*it);
+        ActualSet.erase(it);
+      }
+    } else {
+      ActualSet.insert(key);
+      ExpectedSet.insert(key);
+    }
+    ASSERT_EQ(ActualSet.empty(), ExpectedSet.empty());
+    if (!ExpectedSet.empty()) {
+      ASSERT_EQ(*ActualSet.begin(), *ExpectedSet.begin());
+      ASSERT_EQ(*ActualSet.rbegin(), *ExpectedSet.rbegin());
+    }
+  }
+  EXPECT_TRUE(ActualSet.IsValidTree());
+
+  CheckedSet CopySet(ActualSet);
+  CheckedSet MovedSet(std::move(ActualSet));
+  EXPECT_TRUE(CopySet.IsValidTree());
+  EXPECT_TRUE(MovedSet.IsValidTree());
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  MovedSet.swap(ActualSet);
+  EXPECT_TRUE(MovedSet.IsValidTree());
+  EXPECT_EQ(*--ActualSet.end(), *ExpectedSet.rbegin());
+}
+
+TEST(SetTest, BoundsMatchStdSet) {
+  std::mt19937 gen(10);
+  s21::set<int> ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 2000; ++i) {
+    int key = static_cast<int>(gen() % 10000);
+    ActualSet.insert(key);
+    ExpectedSet.insert(key);
+  }
+
+  for (int key = -1; key <= 10001; ++key) {
+    auto lower = ActualSet.lower_bound(key);
+    auto upper = ActualSet.upper_bound(key);
+    auto expected_lower = ExpectedSet.lower_bound(key);
+    auto expected_upper = ExpectedSet.upper_bound(key);
+    ASSERT_EQ(lower == ActualSet.end(), expected_lower == ExpectedSet.end());
+    ASSERT_EQ(upper == ActualSet.end(), expected_upper == ExpectedSet.end());
+    if (lower != ActualSet.end()) {
+      ASSERT_EQ(*lower, *expected_lower);
+    }
+    if (upper != ActualSet.end()) {
+      ASSERT_EQ(*upper, *expected_upper);
+    }
+
+    auto range = ActualSet.equal_range(key);
+    EXPECT_EQ(range.first, lower);
+    EXPECT_EQ(range.second, upper);
+  }
+}
+
+TEST(SetTest, RangeView) {
+  s21::set<int> ActualSet;
+  for (int i = 0; i < 100; i += 5) ActualSet.insert(i);
+
+  std::vector<int> keys;
+  for (int key : ActualSet.range(12, 40)) keys.push_back(key);
+  EXPECT_EQ(keys, std::vector<int>({15, 20, 25, 30, 35}));
+
+  keys.clear();
+  for (int key : ActualSet.range(90, 1000)) keys.push_back(key);
+  EXPECT_EQ(keys, std::vector<int>({90, 95}));
+
+  EXPECT_TRUE(ActualSet.range(41, 44).empty());
+  EXPECT_TRUE(ActualSet.range(40, 40).empty());
+  EXPECT_TRUE(ActualSet.range(50, 10).empty());
+}
+
+TEST(MapTest, RangeView) {
+  s21::map<int, std::string> ActualMap;
+  for (int i = 0; i < 10; ++i) ActualMap.insert(i * 10, std::to_string(i));
+
+  std::string values;
+  for (auto it = ActualMap.lower_bound(25); it != ActualMap.upper_bound(60);
+       ++it) {
+    values += it->value_;
+  }
+  EXPECT_EQ(values, "3456");
+
+  values.clear();
+  auto window = ActualMap.range(30, 60);
+  for (auto it = window.begin(); it != window.end(); ++it) {
+    values += it->value_;
+  }
+  EXPECT_EQ(values, "345");
+  EXPECT_EQ(*ActualMap.equal_range(40).first, 40);
+}
+
+TEST(MapTest, SquareBracketInserts) {
+  s21::map<std::string, int> Counters;
+  for (const char *word : {"a", "b", "a", "c", "a", "b"}) ++Counters[word];
+
+  EXPECT_EQ(Counters.size(), 3U);
+  EXPECT_EQ(Counters.at("a"), 3);
+  EXPECT_EQ(Counters.at("b"), 2);
+  EXPECT_EQ(Counters["d"], 0);
+  EXPECT_EQ(Counters.size(), 4U);
+}
+
+TEST(MapTest, TryEmplaceAndInsertOrAssign) {
+  s21::map<int, std::string> ActualMap;
+
+  auto [it1, inserted1] = ActualMap.try_emplace(1, 3, 'x');
+  EXPECT_TRUE(inserted1);
+  EXPECT_EQ(it1->value_, "xxx");
+  auto [it2, inserted2] = ActualMap.try_emplace(1, "ignored");
+  EXPECT_FALSE(inserted2);
+  EXPECT_EQ(it2, it1);
+  EXPECT_EQ(it2->value_, "xxx");
+
+  auto [it3, inserted3] = ActualMap.insert_or_assign(1, "one");
+  EXPECT_FALSE(inserted3);
+  EXPECT_EQ(it3, it1);
+  EXPECT_EQ(ActualMap.at(1), "one");
+  EXPECT_TRUE(ActualMap.insert_or_assign(2, "two").second);
+
+  auto [it4, inserted4] = ActualMap.emplace(3, "three");
+  EXPECT_TRUE(inserted4);
+  EXPECT_EQ(*it4, 3);
+  EXPECT_FALSE(ActualMap.emplace(std::make_pair(3, "drei")).second);
+  EXPECT_EQ(ActualMap.at(3), "three");
+  EXPECT_EQ(ActualMap.size(), 3U);
+}
+
+// Neither copyable nor movable, so it can only be built inside the node
+struct Pinned {
+  static inline int built = 0;
+  int value;
+
+  explicit Pinned(int v) : value(v) { ++built; }
+  Pinned(const Pinned &) = delete;
+  Pinned &operator=(const Pinned &) = delete;
+};
+
+TEST(MapTest, EmplaceBuildsInPlace) {
+  s21::map<int, Pinned> ActualMap;
+  Pinned::built = 0;
+
+  EXPECT_TRUE(ActualMap.emplace(1, 10).second);
+  EXPECT_TRUE(ActualMap
+                  .emplace(std::piecewise_construct, std::forward_as_tuple(2),
+                           std::forward_as_tuple(20))
+                  .second);
+  EXPECT_EQ(*ActualMap.emplace_hint(ActualMap.end(), 3, 30), 3);
+  EXPECT_EQ(Pinned::built, 3);
+
+  // A present key builds no mapped value at all
+  EXPECT_FALSE(ActualMap.emplace(1, 99).second);
+  EXPECT_FALSE(ActualMap.emplace(std::make_pair(2, 99)).second);
+  EXPECT_EQ(*ActualMap.emplace_hint(ActualMap.begin(), 3, 99), 3);
+  EXPECT_EQ(Pinned::built, 3);
+  EXPECT_EQ(ActualMap.at(1).value, 10);
+  EXPECT_EQ(ActualMap.at(2).value, 20);
+  EXPECT_EQ(ActualMap.at(3).value, 30);
+}
+
+TEST(MapTest, EmplaceHint) {
+  std::mt19937 gen(11);
+  s21::map<int, int> ActualMap;
+  std::map<int, int> ExpectedMap;
+
+  // Exact hints, as when appending sorted data
+  for (int i = 0; i < 1000; i += 2) {
+    auto it = ActualMap.emplace_hint(ActualMap.end(), i, i);
+    EXPECT_EQ(*it, i);
+    ExpectedMap.emplace(i, i);
+  }
+  // Hints right after the slot, anywhere and past the end
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(gen() % 1200);
+    auto hint = gen() % 2 ? ActualMap.lower_bound(key)
+                          : ActualMap.nth(gen() % ActualMap.size());
+    auto it = ActualMap.emplace_hint(hint, key, -key);
+    EXPECT_EQ(*it, key);
+    ExpectedMap.emplace(key, -key);
+  }
+
+  ASSERT_EQ(ActualMap.size(), ExpectedMap.size());
+  auto expected = ExpectedMap.begin();
+  for (auto it = ActualMap.begin(); it != ActualMap.end(); ++it, ++expected) {
+    EXPECT_EQ(*it, expected->first);
+    EXPECT_EQ(it->value_, expected->second);
+  }
+  EXPECT_EQ(*ActualMap.nth(ActualMap.size() - 1), *--ActualMap.end());
+}
+
+TEST(SetTest, CustomComparator) {
+  s21::set<int, std::greater<int>> ActualSet = {5, 1, 4, 2, 3, 4};
+  std::vector<int> keys(ActualSet.begin(), ActualSet.end());
+
+  EXPECT_EQ(keys, std::vector<int>({5, 4, 3, 2, 1}));
+  EXPECT_TRUE(ActualSet.contains(4));
+  EXPECT_FALSE(ActualSet.contains(6));
+  EXPECT_EQ(*ActualSet.lower_bound(10), 5);
+  EXPECT_EQ(*ActualSet.upper_bound(4), 3);
+  EXPECT_TRUE(ActualSet.key_comp()(2, 1));
+}
+
+// Counts the calls so the tests can check the cost of a descent
+struct CountingLess {
+  int *calls;
+  bool operator()(int lhs, int rhs) const {
+    ++*calls;
+    return lhs < rhs;
+  }
+};
+
+TEST(SetTest, OneComparisonPerLevel) {
+  int calls = 0;
+  s21::set<int, CountingLess> ActualSet(CountingLess{&calls});
+  for (int i = 0; i < 1023; ++i) ActualSet.insert(i);
+
+  // 1023 sorted keys give a red-black tree at most 2 * log2(1024) deep
+  for (int key : {0, 511, 1022, 2000, -1}) {
+    calls = 0;
+    ActualSet.find(key);
+    EXPECT_LE(calls, 2 * 10 + 1);
+  }
+}
+
+TEST(SetTest, TransparentLookup) {
+  s21::set<std::string, std::less<>> ActualSet = {"alpha", "beta", "gamma"};
+  std::string_view name = "beta";
+
+  EXPECT_EQ(*ActualSet.find(name), "beta");
+  EXPECT_TRUE(ActualSet.contains(std::string_view("gamma")));
+  EXPECT_FALSE(ActualSet.contains(std::string_view("delta")));
+  EXPECT_EQ(*ActualSet.lower_bound(std::string_view("b")), "beta");
+  EXPECT_EQ(ActualSet.upper_bound(std::string_view("gamma")),
+            ActualSet.end());
+  EXPECT_EQ(*ActualSet.equal_range(name).first, "beta");
+
+  s21::map<std::string, int, std::less<>> ActualMap;
+  ActualMap["requests"] = 7;
+  EXPECT_EQ(ActualMap.find(std::string_view("requests"))->value_, 7);
+  EXPECT_EQ(ActualMap.find("missing"), ActualMap.end());
+}
+
+TEST(SetTest, FindManyMatchesFind) {
+  std::mt19937 gen(14);
+  s21::set<int> ActualSet;
+  for (int i = 0; i < 5000; ++i) {
+    ActualSet.insert(static_cast<int>(gen() % 20000));
+  }
+  std::vector<int> probes;
+  for (int i = 0; i < 1000; ++i) {
+    probes.push_back(static_cast<int>(gen() % 20000));
+  }
+
+  auto found = ActualSet.find_many(probes.begin(), probes.end());
+  auto contained = ActualSet.contains_many(probes.begin(), probes.end());
+  ASSERT_EQ(found.size(), probes.size());
+  ASSERT_EQ(contained.size(), probes.size());
+  for (size_t i = 0; i < probes.size(); ++i) {
+    EXPECT_EQ(found[i], ActualSet.find(probes[i]));
+    EXPECT_EQ(contained[i], ActualSet.contains(probes[i]));
+  }
+
+  s21::set<int> EmptySet;
+  std::vector<bool> none = EmptySet.contains_many(probes.begin(), probes.end());
+  EXPECT_EQ(std::count(none.begin(), none.end(), true), 0);
+  EXPECT_TRUE(ActualSet.find_many(probes.end(), probes.end()).empty());
+}
+
+TEST(MapTest, FindMany) {
+  s21::map<std::string, int> ActualMap;
+  ActualMap["a"] = 1;
+  ActualMap["c"] = 3;
+  std::vector<std::string> probes = {"c", "b", "a"};
+
+  auto found = ActualMap.find_many(probes.begin(), probes.end());
+  EXPECT_EQ(found[0]->value_, 3);
+  EXPECT_EQ(found[1], ActualMap.end());
+  EXPECT_EQ(found[2]->value_, 1);
+  EXPECT_EQ(ActualMap.contains_many(probes.begin(), probes.end()),
+            std::vector<bool>({true, false, true}));
+}
+
+TEST(SetTest, SplitAndJoin) {
+  std::mt19937 gen(15);
+  CheckedSet ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(gen() % 10000);
+    ActualSet.insert(key);
+    ExpectedSet.insert(key);
+  }
+  const int *node_of_5000 = &*ActualSet.lower_bound(5000);
+
+  for (int key : {-1, 0, 1234, 5000, 9999, 10000}) {
+    CheckedSet Upper;
+    Upper.join(ActualSet.split(key));
+    EXPECT_TRUE(ActualSet.IsValidTree());
+    EXPECT_TRUE(Upper.IsValidTree());
+    std::set<int> ExpectedLower(ExpectedSet.begin(),
+                                ExpectedSet.lower_bound(key));
+    std::set<int> ExpectedUpper(ExpectedSet.lower_bound(key),
+                                ExpectedSet.end());
+    CompareSets<int>(ActualSet, ExpectedLower);
+    CompareSets<int>(Upper, ExpectedUpper);
+
+    ActualSet.join(Upper);
+    EXPECT_TRUE(Upper.empty());
+    EXPECT_TRUE(ActualSet.IsValidTree());
+    CompareSets<int>(ActualSet, ExpectedSet);
+  }
+  // Nodes were only relinked
+  EXPECT_EQ(&*ActualSet.lower_bound(5000), node_of_5000);
+}
+
+TEST(SetTest, JoinOverlappingMerges) {
+  CheckedSet ActualSet1 = {1, 5, 9};
+  CheckedSet ActualSet2 = {2, 5, 12};
+  ActualSet1.join(ActualSet2);
+
+  std::set<int> ExpectedSet = {1, 2, 5, 9, 12};
+  EXPECT_TRUE(ActualSet1.IsValidTree());
+  CompareSets<int>(ActualSet1, ExpectedSet);
+  EXPECT_EQ(ActualSet2.size(), 1U);
+}
+
+TEST(SetTest, ExtractRange) {
+  CheckedSet ActualSet;
+  for (int i = 0; i < 1000; ++i) ActualSet.insert(i);
+
+  CheckedSet Middle;
+  Middle.join(ActualSet.extract(ActualSet.find(100), ActualSet.find(900)));
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  EXPECT_TRUE(Middle.IsValidTree());
+  EXPECT_EQ(ActualSet.size(), 200U);
+  EXPECT_EQ(Middle.size(), 800U);
+  EXPECT_EQ(*Middle.begin(), 100);
+  EXPECT_EQ(*Middle.rbegin(), 899);
+  EXPECT_EQ(*ActualSet.nth(100), 900);
+
+  CheckedSet Tail;
+  Tail.join(ActualSet.extract(ActualSet.find(950), ActualSet.end()));
+  EXPECT_EQ(Tail.size(), 50U);
+  EXPECT_EQ(*ActualSet.rbegin(), 949);
+  EXPECT_TRUE(ActualSet.extract(ActualSet.end(), ActualSet.end()).empty());
+}
+
+TEST(SetTest, PoolStorageSplitAndJoin) {
+  CheckedPoolSet ActualSet;
+  for (int i = 0; i < 5000; ++i) ActualSet.insert(i);
+
+  CheckedPoolSet Upper;
+  Upper.join(ActualSet.split(2500));
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  EXPECT_TRUE(Upper.IsValidTree());
+  EXPECT_EQ(ActualSet.size(), 2500U);
+  EXPECT_EQ(*Upper.begin(), 2500);
+
+  ActualSet.join(Upper);
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  EXPECT_EQ(ActualSet.size(), 5000U);
+}
+
+TEST(MapTest, SplitKeepsValues) {
+  s21::map<int, std::string> ActualMap;
+  for (int i = 0; i < 10; ++i) ActualMap[i] = std::to_string(i);
+
+  auto Upper = ActualMap.split(7);
+  EXPECT_EQ(ActualMap.size(), 7U);
+  EXPECT_EQ(Upper.at(8), "8");
+  ActualMap.join(Upper);
+  EXPECT_EQ(ActualMap.at(9), "9");
+}
+
+TEST(SetTest, FingerMatchesLowerBound) {
+  std::mt19937 gen(16);
+  s21::set<int> ActualSet;
+  for (int i = 0; i < 4000; ++i) {
+    ActualSet.insert(static_cast<int>(gen() % 8000));
+  }
+
+  std::vector<int> probes;
+  for (int key = -5; key < 8005; key += 3) probes.push_back(key);
+  std::vector<int> descending(probes.rbegin(), probes.rend());
+  std::vector<int> scattered;
+  for (int i = 0; i < 3000; ++i) {
+    scattered.push_back(static_cast<int>(gen() % 8010) - 5);
+  }
+
+  for (const auto *sequence : {&probes, &descending, &scattered}) {
+    auto cursor = ActualSet.finger();
+    for (int key : *sequence) {
+      ASSERT_EQ(cursor.lower_bound(key), ActualSet.lower_bound(key));
+      ASSERT_EQ(cursor.find(key), ActualSet.find(key));
+      ASSERT_EQ(cursor.contains(key), ActualSet.contains(key));
+    }
+  }
+}
+
+TEST(SetTest, FingerCostFollowsDistance) {
+  int calls = 0;
+  s21::set<int, CountingLess> ActualSet(CountingLess{&calls});
+  for (int i = 0; i < 100000; ++i) ActualSet.insert(i);
+
+  auto cursor = ActualSet.finger();
+  cursor.find(0);
+  calls = 0;
+  for (int i = 1; i < 100000; ++i) cursor.find(i);
+  // A plain find costs about log2(100000) = 17 comparisons per key
+  EXPECT_LT(calls / 100000, 8);
+}
+
+TEST(MapTest, MergeJoin) {
+  s21::map<int, std::string> ActualMap;
+  for (int i = 0; i < 100; i += 3) ActualMap[i] = std::to_string(i);
+  std::vector<int> probes = {0, 1, 3, 4, 30, 31, 99, 150};
+
+  std::vector<std::string> matched;
+  ActualMap.merge_join(probes.begin(), probes.end(),
+                       [&matched](int key, auto it) {
+                         EXPECT_EQ(*it, key);
+                         matched.push_back(it->value_);
+                       });
+  EXPECT_EQ(matched, std::vector<std::string>({"0", "3", "30", "99"}));
+}
+
+TEST(SetTest, SplayMatchesStdSet) {
+  std::mt19937 gen(17);
+  SplaySet ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 3000);
+    switch (gen() % 4) {
+      case 0:
+        ASSERT_EQ(ActualSet.insert(key).second,
+                  ExpectedSet.insert(key).second);
+        break;
+      case 1:
+        if (ExpectedSet.erase(key)) ActualSet.erase(ActualSet.find(key));
+        break;
+      default:
+        ASSERT_EQ(ActualSet.contains(key), ExpectedSet.count(key) == 1);
+    }
+  }
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  EXPECT_TRUE(std::equal(ActualSet.begin(), ActualSet.end(),
+                         ExpectedSet.begin(), ExpectedSet.end()));
+  auto expected = ExpectedSet.begin();
+  for (size_t i = 0; i < ExpectedSet.size(); i += 97) {
+    std::advance(expected, i == 0 ? 0 : 97);
+    ASSERT_EQ(*ActualSet.nth(i), *expected);
+    ASSERT_EQ(ActualSet.rank(*expected), i);
+  }
+}
+
+TEST(SetTest, SplayMovesFoundKeyToRoot) {
+  SplaySet ActualSet;
+  for (int i = 0; i < 1000; ++i) ActualSet.insert(i);
+  EXPECT_EQ(*ActualSet.RootKey(), 999);
+
+  EXPECT_NE(ActualSet.find(17), ActualSet.end());
+  EXPECT_EQ(*ActualSet.RootKey(), 17);
+  EXPECT_TRUE(ActualSet.contains(400));
+  EXPECT_EQ(*ActualSet.RootKey(), 400);
+  EXPECT_FALSE(ActualSet.insert(3).second);
+  EXPECT_EQ(*ActualSet.RootKey(), 3);
+  EXPECT_TRUE(ActualSet.IsValidTree());
+}
+
+TEST(SetTest, SplaySplitAndJoin) {
+  SplaySet ActualSet;
+  for (int i = 0; i < 5000; ++i) ActualSet.insert((i * 7919) % 5000);
+
+  SplaySet Upper;
+  Upper.join(ActualSet.split(1234));
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  EXPECT_TRUE(Upper.IsValidTree());
+  EXPECT_EQ(ActualSet.size(), 1234U);
+  EXPECT_EQ(*Upper.begin(), 1234);
+  EXPECT_EQ(*ActualSet.rbegin(), 1233);
+
+  ActualSet.join(Upper);
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  EXPECT_EQ(ActualSet.size(), 5000U);
+  EXPECT_EQ(ActualSet.rank(4000), 4000U);
+
+  SplayPoolSet PoolSet;
+  for (int i = 0; i < 100; ++i) PoolSet.insert(i);
+  SplayPoolSet PoolUpper;
+  PoolUpper.join(PoolSet.split(60));
+  EXPECT_TRUE(PoolSet.IsValidTree());
+  EXPECT_TRUE(PoolUpper.IsValidTree());
+  EXPECT_EQ(PoolUpper.size(), 40U);
+}
+
+TEST(MapTest, SplayMap) {
+  s21::map<int, std::string, std::less<int>, s21::HeapStorage,
+           s21::SplayBalance>
+      ActualMap;
+  for (int i = 0; i < 100; ++i) ActualMap[i % 10] += "x";
+  EXPECT_EQ(ActualMap.size(), 10U);
+  EXPECT_EQ(ActualMap.at(4), "xxxxxxxxxx");
+  ActualMap.insert_or_assign(4, "y");
+  EXPECT_EQ(ActualMap.at(4), "y");
+  ActualMap.erase(ActualMap.find(4));
+  EXPECT_FALSE(ActualMap.contains(4));
+}
+
+TEST(SetTest, EraseRange) {
+  // Few removed keys are unlinked one by one, many rebuild the tree
+  for (int removed : {10, 3000}) {
+    CheckedSet ActualSet;
+    std::set<int> ExpectedSet;
+    for (int i = 0; i < 10000; ++i) {
+      ActualSet.insert((i * 7919) % 10000);
+      ExpectedSet.insert(i);
+    }
+    auto next = ActualSet.erase(ActualSet.find(4000),
+                                ActualSet.find(4000 + removed));
+    ExpectedSet.erase(ExpectedSet.find(4000), ExpectedSet.find(4000 + removed));
+    EXPECT_EQ(*next, 4000 + removed);
+    EXPECT_TRUE(ActualSet.IsValidTree());
+    CompareSets(ActualSet, ExpectedSet);
+    EXPECT_EQ(*ActualSet.nth(4000), 4000 + removed);
+  }
+
+  CheckedPoolSet PoolSet;
+  for (int i = 0; i < 1000; ++i) PoolSet.insert(i);
+  EXPECT_EQ(PoolSet.erase(PoolSet.begin(), PoolSet.end()), PoolSet.end());
+  EXPECT_TRUE(PoolSet.empty());
+  EXPECT_TRUE(PoolSet.IsValidTree());
+  PoolSet.insert(5);
+  EXPECT_EQ(*PoolSet.begin(), 5);
+}
+
+TEST(SetTest, EraseKeyAndEraseIf) {
+  CheckedSet ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 5000; ++i) {
+    ActualSet.insert(i);
+    ExpectedSet.insert(i);
+  }
+  EXPECT_EQ(ActualSet.erase(17), 1U);
+  EXPECT_EQ(ActualSet.erase(17), 0U);
+  ExpectedSet.erase(17);
+
+  EXPECT_EQ(s21::erase_if(ActualSet,
+                          [](const auto &entry) { return entry.key_ == 5; }),
+            1U);
+  ExpectedSet.erase(5);
+  EXPECT_TRUE(ActualSet.IsValidTree());
+
+  // About a third of the keys, as a TTL sweep would
+  auto expired = [](const auto &entry) { return entry.key_ % 3 == 1; };
+  EXPECT_EQ(s21::erase_if(ActualSet, expired), 1667U);
+  for (auto it = ExpectedSet.begin(); it != ExpectedSet.end();) {
+    it = *it % 3 == 1 ? ExpectedSet.erase(it) : std::next(it);
+  }
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  CompareSets(ActualSet, ExpectedSet);
+
+  // A throwing predicate keeps what it has not decided on yet
+  auto throwing = [](const auto &entry) {
+    if (entry.key_ > 3000) throw std::runtime_error("stop");
+    return entry.key_ < 1000;
+  };
+  EXPECT_THROW(s21::erase_if(ActualSet, throwing), std::runtime_error);
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  EXPECT_EQ(*ActualSet.begin(), 1001);
+  EXPECT_EQ(*ActualSet.rbegin(), 4998);
+
+  SplaySet Splay;
+  for (int i = 0; i < 3000; ++i) Splay.insert(i);
+  EXPECT_EQ(s21::erase_if(Splay, expired), 1000U);
+  EXPECT_TRUE(Splay.IsValidTree());
+  EXPECT_EQ(Splay.erase(Splay.find(3), Splay.find(9)), Splay.find(9));
+  EXPECT_TRUE(Splay.IsValidTree());
+  EXPECT_EQ(Splay.size(), 1996U);
+}
+
+TEST(MapTest, EraseIfSeesValues) {
+  s21::map<int, std::string> ActualMap;
+  for (int i = 0; i < 1000; ++i) ActualMap[i] = i % 2 ? "odd" : "even";
+  EXPECT_EQ(s21::erase_if(ActualMap,
+                          [](const auto &entry) {
+                            return entry.value_ == "odd";
+                          }),
+            500U);
+  EXPECT_EQ(ActualMap.size(), 500U);
+  EXPECT_EQ(ActualMap.at(998), "even");
+  EXPECT_EQ(ActualMap.erase(998), 1U);
+  ActualMap.erase(ActualMap.begin(), ActualMap.find(500));
+  EXPECT_EQ(*ActualMap.begin(), 500);
+  EXPECT_EQ(ActualMap.size(), 249U);
+}
+
+TEST(SetTest, ExtractAndInsertNode) {
+  s21::set<int> ActualSet1 = {1, 2, 3, 4};
+  s21::set<int> ActualSet2 = {10};
+
+  auto node = ActualSet1.extract(3);
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ(node.key(), 3);
+  EXPECT_FALSE(ActualSet1.contains(3));
+  EXPECT_EQ(ActualSet1.size(), 3U);
+
+  auto result = ActualSet2.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ(*result.position, 3);
+  EXPECT_TRUE(result.node.empty());
+  EXPECT_TRUE(node.empty());
+
+  auto missing = ActualSet1.extract(42);
+  EXPECT_TRUE(missing.empty());
+
+  auto duplicate = ActualSet1.extract(ActualSet1.begin());
+  ActualSet2.insert(1);
+  auto rejected = ActualSet2.insert(std::move(duplicate));
+  EXPECT_FALSE(rejected.inserted);
+  EXPECT_EQ(rejected.node.key(), 1);
+
+  std::set<int> ExpectedSet1 = {2, 4};
+  std::set<int> ExpectedSet2 = {1, 3, 10};
+  CompareSets(ActualSet1, ExpectedSet1);
+  CompareSets(ActualSet2, ExpectedSet2);
+}
+
+TEST(SetTest, MergeRelinksNodes) {
+  CheckedSet ActualSet1;
+  CheckedSet ActualSet2;
+  std::set<int> ExpectedSet1;
+  std::set<int> ExpectedSet2;
+  for (int i = 0; i < 20000; i += 2) {
+    ActualSet1.insert(i);
+    ExpectedSet1.insert(i);
+  }
+  for (int i = 0; i < 20000; i += 3) {
+    ActualSet2.insert(i);
+    ExpectedSet2.insert(i);
+  }
+  const int *moved = &*ActualSet2.find(9);
+
+  ActualSet1.merge(ActualSet2);
+  ExpectedSet1.merge(ExpectedSet2);
+
+  EXPECT_EQ(&*ActualSet1.find(9), moved);
+  EXPECT_TRUE(ActualSet1.IsValidTree());
+  EXPECT_TRUE(ActualSet2.IsValidTree());
+  CompareSets<int>(ActualSet1, ExpectedSet1);
+  CompareSets<int>(ActualSet2, ExpectedSet2);
+}
+
+TEST(SetTest, RangeConstructorSorted) {
+  std::vector<int> keys(100000);
+  std::iota(keys.begin(), keys.end(), 0);
+  CheckedSet ActualSet(keys.begin(), keys.end());
+  std::set<int> ExpectedSet(keys.begin(), keys.end());
+
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  CompareSets<int>(ActualSet, ExpectedSet);
+}
+
+TEST(SetTest, RangeConstructorUnsortedWithDuplicates) {
+  std::vector<int> keys = {9, 3, 7, 3, 1, 9, 12, 0, 7, 5, 5, 2};
+  CheckedSet ActualSet(keys.begin(), keys.end());
+  std::set<int> ExpectedSet(keys.begin(), keys.end());
+
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  CompareSets<int>(ActualSet, ExpectedSet);
+}
+
+TEST(SetTest, Assign) {
+  CheckedSet ActualSet = {100, 200, 300};
+  std::vector<int> keys = {4, 8, 15, 16, 23, 42};
+  ActualSet.assign(keys.begin(), keys.end());
+  std::set<int> ExpectedSet(keys.begin(), keys.end());
+
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  CompareSets<int>(ActualSet, ExpectedSet);
+}
+
+TEST(SetTest, InsertMany) {
+  CheckedSet ActualSet = {5, 10};
+
+  auto result = ActualSet.insert_many(7, 5, 1, 7);
+  ASSERT_EQ(result.size(), 4U);
+  EXPECT_EQ(*result[0].first, 7);
+  EXPECT_TRUE(result[0].second);
+  EXPECT_EQ(*result[1].first, 5);
+  EXPECT_FALSE(result[1].second);
+  EXPECT_EQ(*result[2].first, 1);
+  EXPECT_TRUE(result[2].second);
+  EXPECT_EQ(result[3].first, result[0].first);
+  EXPECT_FALSE(result[3].second);
+
+  std::set<int> ExpectedSet = {1, 5, 7, 10};
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  CompareSets<int>(ActualSet, ExpectedSet);
+}
+
+TEST(SetTest, InsertManyIntoLargeSet) {
+  std::vector<int> keys(1000);
+  std::iota(keys.begin(), keys.end(), 0);
+  CheckedSet ActualSet(keys.begin(), keys.end());
+  std::set<int> ExpectedSet(keys.begin(), keys.end());
+
+  auto result = ActualSet.insert_many(-1, 500, 2000);
+  EXPECT_TRUE(result[0].second);
+  EXPECT_FALSE(result[1].second);
+  EXPECT_TRUE(result[2].second);
+  ExpectedSet.insert({-1, 2000});
+
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  CompareSets<int>(ActualSet, ExpectedSet);
+}
+
+TEST(SetTest, PoolStorageMatchesStdSet) {
+  CheckedPoolSet ActualSet;
+  std::set<int> ExpectedSet;
+  std::mt19937 gen(6);
+  std::uniform_int_distribution<int> dist(0, 9999);
+
+  for (int i = 0; i < 30000; ++i) {
+    int key = dist(gen);
+    if (i % 2 == 0 && ActualSet.contains(key)) {
+      ActualSet.erase(ActualSet.find(key));
+      ExpectedSet.erase(key);
+    } else {
+      ActualSet.insert(key);
+      ExpectedSet.insert(key);
+    }
+  }
+
+  EXPECT_TRUE(ActualSet.IsValidTree());
+  CompareSets<int>(ActualSet, ExpectedSet);
+
+  ActualSet.clear();
+  ExpectedSet.clear();
+  CompareSets<int>(ActualSet, ExpectedSet);
+  ActualSet.insert(5);
+  EXPECT_TRUE(ActualSet.contains(5));
+}
+
+TEST(SetTest, PoolStorageCopyMoveSwap) {
+  PoolStringSet ActualSet1 = {"b", "a", "c"};
+  PoolStringSet CopySet(ActualSet1);
+  PoolStringSet MoveSet(std::move(ActualSet1));
+  std::set<std::string> ExpectedSet = {"a", "b", "c"};
+  std::set<std::string> EmptySet;
+
+  CompareSets(CopySet, ExpectedSet);
+  CompareSets(MoveSet, ExpectedSet);
+  CompareSets(ActualSet1, EmptySet);
+
+  PoolStringSet ActualSet2 = {"x"};
+  ActualSet2.swap(MoveSet);
+  std::set<std::string> ExpectedSet2 = {"x"};
+  CompareSets(ActualSet2, ExpectedSet);
+  CompareSets(MoveSet, ExpectedSet2);
+
+  ActualSet1 = CopySet;
+  CompareSets(ActualSet1, ExpectedSet);
+}
+
+TEST(SetTest, PoolStorageMergeAndNodeHandles) {
+  CheckedPoolSet ActualSet1 = {1, 3, 5};
+  CheckedPoolSet ActualSet2 = {2, 3, 4, 6};
+
+  ActualSet1.merge(ActualSet2);
+  auto node = ActualSet1.extract(6);
+  ActualSet2.insert(std::move(node));
+  auto rejected = ActualSet2.insert(ActualSet1.extract(3));
+  EXPECT_FALSE(rejected.inserted);
+
+  std::set<int> ExpectedSet1 = {1, 2, 4, 5};
+  std::set<int> ExpectedSet2 = {3, 6};
+  EXPECT_TRUE(ActualSet1.IsValidTree());
+  EXPECT_TRUE(ActualSet2.IsValidTree());
+  CompareSets<int>(ActualSet1, ExpectedSet1);
+  CompareSets<int>(ActualSet2, ExpectedSet2);
+}
+
+TEST(SetTest, CopyLargeSet) {
+  std::mt19937 gen(8);
+  CheckedSet ActualSet;
+  std::set<int> ExpectedSet;
+  for (int i = 0; i < 100000; ++i) {
+    int key = static_cast<int>(gen());
+    ActualSet.insert(key);
+    ExpectedSet.insert(key);
+  }
+
+  CheckedSet CopySet(ActualSet);
+  ActualSet.clear();
+
+  EXPECT_TRUE(CopySet.IsValidTree());
+  CompareSets<int>(CopySet, ExpectedSet);
+  EXPECT_EQ(*CopySet.nth(500), *std::next(ExpectedSet.begin(), 500));
+}
+
+// A 64-byte identifier, the typical payload of a dedup set
+struct Identifier {
+  char bytes[64];
+  bool operator<(const Identifier &other) const {
+    return std::memcmp(bytes, other.bytes, sizeof(bytes)) < 0;
+  }
+};
+
+class IdentifierSet : public s21::set<Identifier> {
+ public:
+  static constexpr size_t kNodeSize = sizeof(Node);
+};
+
+TEST(SetTest, NodeStoresKeyOnce) {
+  // key + parent/left/right + one word for subtree count and colour
+  EXPECT_EQ(IdentifierSet::kNodeSize, sizeof(Identifier) + 4 * sizeof(void *));
+
+  IdentifierSet ActualSet;
+  Identifier id{};
+  for (char c = 'a'; c <= 'z'; ++c) {
+    id.bytes[0] = c;
+    ActualSet.insert(id);
+  }
+  EXPECT_EQ(ActualSet.size(), 26U);
+  id.bytes[0] = 'q';
+  EXPECT_TRUE(ActualSet.contains(id));
+  EXPECT_EQ(ActualSet.rank(id), 16U);
+}
+
+// Its copy constructor throws once copies_left runs out
+struct FragileKey {
+  static inline int copies_left = 0;
+  int value = 0;
+
+  FragileKey(int v) : value(v) {}
+  FragileKey(const FragileKey &other) : value(other.value) {
+    if (copies_left-- == 0) throw std::runtime_error("copy");
+  }
+  bool operator<(const FragileKey &other) const { return value < other.value; }
+};
+
+TEST(SetTest, AssignFreesBatchOnThrow) {
+  FragileKey::copies_left = 100;
+  std::vector<FragileKey> keys = {5, 1, 4, 2, 3};
+  s21::set<FragileKey> ActualSet;
+
+  // The third node fails, the two made before it must not leak
+  FragileKey::copies_left = 2;
+  EXPECT_THROW(ActualSet.assign(keys.begin(), keys.end()),
+               std::runtime_error);
+  EXPECT_TRUE(ActualSet.empty());
+}
+
+TEST(SetTest, InsertManyFreesBatchOnThrow) {
+  FragileKey::copies_left = 100;
+  FragileKey one(1), two(2), three(3);
+  s21::set<FragileKey> ActualSet;
+
+  FragileKey::copies_left = 2;
+  EXPECT_THROW(ActualSet.insert_many(one, two, three), std::runtime_error);
+  EXPECT_TRUE(ActualSet.empty());
+
+  FragileKey::copies_left = 100;
+  std::pair<FragileKey, int> first(one, 1), second(two, 2), third(three, 3);
+  s21::map<FragileKey, int> ActualMap;
+  FragileKey::copies_left = 2;
+  EXPECT_THROW(ActualMap.insert_many(first, second, third),
+               std::runtime_error);
+  EXPECT_TRUE(ActualMap.empty());
+}
+
 // TEST(MapTest, At) {
 //   s21::map<int, std::string> ActualMap = {{1, "one"}, {2, "two"}};
 